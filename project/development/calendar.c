@@ -0,0 +1,181 @@
+/**
+ * @file calendar.c
+ * @author Diogo Santos (ist1110262)
+ * @brief Conversions between dates and the minutes they are stored as.
+ *
+ * Every date is kept as its minutes since 01-01-0000 00:00, on a calendar
+ * where all years have 365 days: there are no leap years, so 29-02 is not
+ * a valid date and is never billed. Weekdays still follow the real
+ * calendar. Parsed dates are converted once and
+ * dates are only rebuilt from their minutes when they are written.
+ *
+ * @version 1
+ * @date 27-03-2024
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "headers.h"
+
+// Array with total days in a month.
+const int days_in_month[] = {
+	JAN, FEB, MAR, APR, MAY, JUN,
+	JUL, AUG, SEP, OCT, NOV, DEC};
+
+// Array with the days of the year before each month.
+const int days_before_month[] = {
+	0, 31, 59, 90, 120, 151,
+	181, 212, 243, 273, 304, 334};
+
+/**
+ * @brief Converts a date to minutes.
+ *
+ * @param d Pointer to the date structure.
+ * @return The date converted to minutes.
+ */
+long int date_to_minutes(date *d) {
+	long int minutes;
+
+	minutes = (long int)d->years * DAYS_IN_YEAR * MINS_PER_DAY;
+
+	// Invalid months are rejected later, their minutes don't matter.
+	if (d->months >= 1 && d->months <= 12) {
+		minutes += days_before_month[d->months - 1] * MINS_PER_DAY;
+	}
+
+	minutes += (d->days - 1) * MINS_PER_DAY;
+	minutes += d->hours * MINS_PER_HOUR;
+	minutes += d->minutes;
+
+	return minutes;
+}
+
+/**
+ * @brief Converts minutes back into a date, the inverse of date_to_minutes
+ * for valid dates.
+ *
+ * Years are counted from March, so February is their last month and the
+ * lengths of the months before it follow a closed form.
+ *
+ * @param total_mins Minutes to convert.
+ * @param d Pointer to the date structure to fill.
+ */
+void minutes_to_date(long int total_mins, date *d) {
+	long int days = day_number(total_mins) - MARCH_OFFSET;
+	long int years = floor_divide(days, DAYS_IN_YEAR);
+	int day_of_year = days - years * DAYS_IN_YEAR;
+	int month = (5 * day_of_year + 2) / MONTH_CYCLE_DAYS;
+
+	d->days = day_of_year - (MONTH_CYCLE_DAYS * month + 2) / 5 + 1;
+	d->months = (month < 10) ? month + 3 : month - 9;
+	d->years = years + (d->months <= 2);
+	d->hours = minute_of_day(total_mins) / MINS_PER_HOUR;
+	d->minutes = minute_of_day(total_mins) % MINS_PER_HOUR;
+	d->total_mins = total_mins;
+}
+
+/**
+ * @brief Checks if a date is valid.
+ *
+ * @param d Pointer to the date structure.
+ * @return TRUE if the date is valid, FALSE otherwise.
+ */
+bool is_valid_date(date *d) {
+	if (d->months < 1 || d->months > 12) return FALSE;
+	if (d->days > days_in_month[d->months - 1] || d->days < 1) return FALSE;
+	if (d->hours >= 24 || d->hours < 0) return FALSE;
+	if (d->minutes >= 60 || d->minutes < 0) return FALSE;
+
+	return TRUE;
+}
+
+/**
+ * @brief Divides rounding towards minus infinity, as years may be negative.
+ *
+ * @param value Value to divide.
+ * @param divisor Positive divisor.
+ * @return The quotient, rounded down.
+ */
+long int floor_divide(long int value, long int divisor) {
+	long int quotient = value / divisor;
+
+	if (quotient * divisor > value) quotient--;
+	return quotient;
+}
+
+/**
+ * @brief Gets the day a minute falls on, counted from 01-01-0000.
+ *
+ * @param total_mins Minutes of the date.
+ * @return Number of the day.
+ */
+long int day_number(long int total_mins) {
+	return floor_divide(total_mins, MINS_PER_DAY);
+}
+
+/**
+ * @brief Gets the minutes elapsed since the start of the day.
+ *
+ * @param total_mins Minutes of the date.
+ * @return Minutes since midnight.
+ */
+int minute_of_day(long int total_mins) {
+	return total_mins - day_number(total_mins) * MINS_PER_DAY;
+}
+
+/**
+ * @brief Counts the leap days the calendar leaves out before a minute.
+ *
+ * Years are counted from March, so the 29-02 of a year is only counted
+ * from the 1st of March on.
+ *
+ * @param total_mins Minutes of the date.
+ * @return Number of leap days since 01-03-0000.
+ */
+long int leap_days(long int total_mins) {
+	long int years =
+		floor_divide(day_number(total_mins) - MARCH_OFFSET, DAYS_IN_YEAR);
+
+	return floor_divide(years, LEAP_YEAR_CYCLE) -
+		   floor_divide(years, CENTURY_YEARS) +
+		   floor_divide(years, LEAP_CENTURY_CYCLE);
+}
+
+/**
+ * @brief Gets the weekday a minute falls on.
+ *
+ * Weekdays follow the real calendar, so the leap days missing from the day
+ * numbers are added back before counting weeks.
+ *
+ * @param total_mins Minutes of the date.
+ * @return Weekday, 0 for Monday to 6 for Sunday.
+ */
+int weekday(long int total_mins) {
+	long int day =
+		day_number(total_mins) + leap_days(total_mins) + WEEKDAY_OFFSET;
+
+	return day - floor_divide(day, DAYS_PER_WEEK) * DAYS_PER_WEEK;
+}
+
+/**
+ * @brief Gets the quarter-hour of the week a minute falls in.
+ *
+ * @param total_mins Minutes of the date.
+ * @return Quarter-hour, counted from midnight of Monday.
+ */
+int quarter_of_week(long int total_mins) {
+	return weekday(total_mins) * QUARTERS_PER_DAY +
+		   minute_of_day(total_mins) / PARK_PAY_STEP;
+}
+
+/**
+ * @brief Checks if two dates are the same day.
+ *
+ * @param mins1 Minutes of the first date.
+ * @param mins2 Minutes of the second date.
+ * @return TRUE if the dates are the same day, FALSE otherwise.
+ */
+bool is_same_day(long int mins1, long int mins2) {
+	return day_number(mins1) == day_number(mins2);
+}
@@ -0,0 +1,52 @@
+/**
+ * @file calendar.h
+ * @author Diogo Santos (ist1110262)
+ * @brief Declarations of the date conversions.
+ * @version 1
+ * @date 27-03-2024
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef CALENDAR
+#define CALENDAR
+
+#include "headers.h"
+
+/// @defgroup calendar_functions Date conversion related functions.
+/// @{
+
+/// Transforms date into minutes.
+long int date_to_minutes(date *d);
+
+/// Transforms minutes back into a date.
+void minutes_to_date(long int total_mins, date *d);
+
+/// Validates a date.
+bool is_valid_date(date *d);
+
+/// Divides rounding towards minus infinity.
+long int floor_divide(long int value, long int divisor);
+
+/// Gets the day a minute falls on.
+long int day_number(long int total_mins);
+
+/// Gets the minutes elapsed since the start of the day.
+int minute_of_day(long int total_mins);
+
+/// Counts the leap days the calendar leaves out before a minute.
+long int leap_days(long int total_mins);
+
+/// Gets the weekday a minute falls on.
+int weekday(long int total_mins);
+
+/// Gets the quarter-hour of the week a minute falls in.
+int quarter_of_week(long int total_mins);
+
+/// Verifies if it is the same day.
+bool is_same_day(long int mins1, long int mins2);
+
+/// @}
+
+#endif
@@ -0,0 +1,710 @@
+/**
+ * @file command_log.c
+ * @author Diogo Santos (ist1110262)
+ * @brief Binary command log, compiled from text commands and replayed
+ * without parsing them again.
+ *
+ * A log starts with LOG_MAGIC and is followed by records, each made of an
+ * opcode and its fields in native byte order. Commands keep their letter as
+ * opcode, parks are referred to by the id of their name, plates by their
+ * plate id and stamps by their minutes. Names are defined by a DEFINE_NAME
+ * record before their first use, and get ids in order of definition.
+ *
+ * @version 1
+ * @date 27-03-2024
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "headers.h"
+
+/**
+ * @brief Initializes an empty name table.
+ *
+ * @param table Name table to initialize.
+ */
+void init_name_table(name_table *table) {
+	table->names = NULL;
+	table->parks = NULL;
+	table->name_num = 0;
+	table->name_size = 0;
+	table->slot_size = NAME_SLOTS;
+	table->slots = malloc(NAME_SLOTS * sizeof(int));
+	memset(table->slots, NO_NAME, NAME_SLOTS * sizeof(int));
+}
+
+/**
+ * @brief Frees the memory of a name table.
+ *
+ * @param table Name table to free.
+ */
+void free_name_table(name_table *table) {
+	int i;
+
+	for (i = 0; i < table->name_num; i++) {
+		free(table->names[i].str);
+	}
+	free(table->names);
+	free(table->parks);
+	free(table->slots);
+}
+
+/**
+ * @brief Finds the slot of a name, or the empty slot where it belongs.
+ *
+ * @param table Name table to search.
+ * @param name Name to find.
+ * @return Pointer to the slot.
+ */
+int *find_name_slot(name_table *table, name_view *name) {
+	int i = name->hash & (table->slot_size - 1), id;
+	name_view *entry;
+
+	while ((id = table->slots[i]) != NO_NAME) {
+		entry = &(table->names[id]);
+		if (entry->hash == name->hash && entry->size == name->size &&
+			memcmp(entry->str, name->str, name->size) == 0) {
+			break;
+		}
+		i = (i + 1) & (table->slot_size - 1);
+	}
+
+	return &(table->slots[i]);
+}
+
+/**
+ * @brief Adds a copy of a name to a name table.
+ *
+ * @param table Name table to add to.
+ * @param name Name to add, which needs no null terminator.
+ * @return Id of the name.
+ */
+int add_name(name_table *table, name_view *name) {
+	name_view *entry;
+	int id = table->name_num;
+
+	if (table->name_num == table->name_size) {
+		table->names =
+			grow_array(table->names, &(table->name_size), sizeof(name_view));
+		table->parks =
+			realloc(table->parks, table->name_size * sizeof(park *));
+	}
+	table->parks[id] = NULL;
+
+	entry = &(table->names[id]);
+	entry->str = malloc(name->size + 1);
+	memcpy(entry->str, name->str, name->size);
+	entry->str[name->size] = '\0';
+	entry->size = name->size;
+	entry->hash = hash(entry->str);
+	table->name_num++;
+
+	if (table->name_num > table->slot_size * MAX_LOAD_FACTOR) {
+		grow_name_slots(table);
+	} else {
+		*find_name_slot(table, entry) = id;
+	}
+	return id;
+}
+
+/**
+ * @brief Doubles the slots of a name table, placing every name again.
+ *
+ * @param table Name table to grow.
+ */
+void grow_name_slots(name_table *table) {
+	int i;
+
+	free(table->slots);
+	table->slot_size *= GROWTH_FACTOR;
+	table->slots = malloc(table->slot_size * sizeof(int));
+	memset(table->slots, NO_NAME, table->slot_size * sizeof(int));
+
+	for (i = 0; i < table->name_num; i++) {
+		*find_name_slot(table, &(table->names[i])) = i;
+	}
+}
+
+/**
+ * @brief Compiles the text commands of the input into a command log.
+ *
+ * Commands are parsed as in text mode, and compiling stops after a 'q'.
+ *
+ * @param in Reader of the text commands.
+ * @param out Writer of the command log.
+ * @return SUCCESSFUL once the input is compiled.
+ */
+error_codes compile_log(input_reader *in, output_writer *out) {
+	name_table table;
+	char *line;
+	int size;
+
+	init_name_table(&table);
+	write_bytes(out, LOG_MAGIC, LOG_MAGIC_SIZE);
+
+	while (TRUE) {
+		line = next_line(in, &size);
+		if (line == NULL) break;
+		line = remove_whitespaces(line);
+		if (!compile_command(line, &table, out)) break;
+	}
+
+	free_name_table(&table);
+	return SUCCESSFUL;
+}
+
+/**
+ * @brief Compiles a single text command into its log record.
+ *
+ * Unknown commands are left out of the log, as they do nothing.
+ *
+ * @param command Text command, without leading whitespaces.
+ * @param table Names defined so far.
+ * @param out Output writer.
+ * @return FALSE after the 'q' command, TRUE otherwise.
+ */
+bool compile_command(char *command, name_table *table, output_writer *out) {
+	char *buff;
+
+	if (*command == '\0') return TRUE;
+	buff = remove_whitespaces(command + 1);
+
+	switch (*command) {
+	case COMMAND_EXIT:
+		write_char(out, COMMAND_EXIT);
+		return FALSE;
+	case CREATE_OR_VIEW:
+		compile_park(buff, table, out);
+		break;
+	case ADD_VEHICLE:
+	case REMOVE_VEHICLE:
+		compile_event(*command, buff, table, out);
+		break;
+	case VIEW_VEHICLE:
+		compile_vehicle(buff, out);
+		break;
+	case PARK_BILLING:
+		compile_billing(buff, table, out);
+		break;
+	case REMOVE_PARK:
+		compile_removal(buff, table, out);
+		break;
+	case SET_TARIFF:
+		compile_band(buff, table, out);
+		break;
+	}
+	return TRUE;
+}
+
+/**
+ * @brief Compiles the creation of a park or the listing of all parks.
+ *
+ * @param buff Arguments of the 'p' command.
+ * @param table Names defined so far.
+ * @param out Output writer.
+ */
+void compile_park(char *buff, name_table *table, output_writer *out) {
+	p_args args = {.error = {NO_ERROR, NULL, 0}};
+	int id;
+
+	if (*buff == '\0') {
+		write_char(out, LIST_PARKS);
+		return;
+	}
+
+	parse_p_args(buff, &args);
+	id = intern_name(&(args.name), table, out);
+	write_char(out, CREATE_OR_VIEW);
+	write_field(out, &id, sizeof(int));
+	write_field(out, &(args.capacity), sizeof(int));
+	write_field(out, &(args.first_value), sizeof(money));
+	write_field(out, &(args.value), sizeof(money));
+	write_field(out, &(args.day_value), sizeof(money));
+}
+
+/**
+ * @brief Compiles a command that takes a park, a plate and a stamp.
+ *
+ * @param opcode Letter of the command, 'e' or 's'.
+ * @param buff Arguments of the command.
+ * @param table Names defined so far.
+ * @param out Output writer.
+ */
+void compile_event(
+	char opcode, char *buff, name_table *table, output_writer *out
+) {
+	e_args args = {.error = {NO_ERROR, NULL, 0}};
+	int id;
+
+	parse_e_args(buff, &args);
+	id = intern_name(&(args.name), table, out);
+	write_char(out, opcode);
+	write_field(out, &id, sizeof(int));
+	write_log_plate(args.plate_id, args.license_plate, out);
+	write_log_stamp(&(args.timestamp), out);
+}
+
+/**
+ * @brief Compiles a billing listing.
+ *
+ * @param buff Arguments of the 'f' command.
+ * @param table Names defined so far.
+ * @param out Output writer.
+ */
+void compile_billing(char *buff, name_table *table, output_writer *out) {
+	f_args args = {
+		.error = {NO_ERROR, NULL, 0}, .timestamp = {.minutes = 0, .hours = 0}};
+	int id;
+
+	parse_f_args(buff, &args);
+	id = intern_name(&(args.name), table, out);
+	write_char(out, PARK_BILLING);
+	write_field(out, &id, sizeof(int));
+	write_char(out, args.has_date);
+	if (args.has_date) write_log_stamp(&(args.timestamp), out);
+}
+
+/**
+ * @brief Compiles a listing of the registries of a vehicle.
+ *
+ * @param buff Arguments of the 'v' command.
+ * @param out Output writer.
+ */
+void compile_vehicle(char *buff, output_writer *out) {
+	char license_plate[LICENSE_PLATE_SIZE + 1] = {0};
+	unsigned int plate_id;
+
+	parse_license_plate(buff, license_plate, &plate_id);
+	write_char(out, VIEW_VEHICLE);
+	write_log_plate(plate_id, license_plate, out);
+}
+
+/**
+ * @brief Compiles the removal of a park.
+ *
+ * @param buff Arguments of the 'r' command.
+ * @param table Names defined so far.
+ * @param out Output writer.
+ */
+void compile_removal(char *buff, name_table *table, output_writer *out) {
+	name_view name;
+	int id;
+
+	parse_name(buff, &name);
+	id = intern_name(&name, table, out);
+	write_char(out, REMOVE_PARK);
+	write_field(out, &id, sizeof(int));
+}
+
+/**
+ * @brief Compiles a tariff band.
+ *
+ * @param buff Arguments of the 't' command.
+ * @param table Names defined so far.
+ * @param out Output writer.
+ */
+void compile_band(char *buff, name_table *table, output_writer *out) {
+	t_args args = {.error = {NO_ERROR, NULL, 0}};
+	int id;
+
+	parse_t_args(buff, &args);
+	id = intern_name(&(args.name), table, out);
+	write_char(out, SET_TARIFF);
+	write_field(out, &id, sizeof(int));
+	write_field(out, &(args.weekdays), sizeof(int));
+	write_field(out, &(args.start), sizeof(int));
+	write_field(out, &(args.end), sizeof(int));
+	write_field(out, &(args.value), sizeof(money));
+}
+
+/**
+ * @brief Gets the id of a park name, defining the name on first use.
+ *
+ * @param name Name of the park.
+ * @param table Names defined so far.
+ * @param out Output writer, where definitions are written.
+ * @return Id of the name.
+ */
+int intern_name(name_view *name, name_table *table, output_writer *out) {
+	int *slot = find_name_slot(table, name);
+
+	if (*slot != NO_NAME) return *slot;
+
+	write_char(out, DEFINE_NAME);
+	write_field(out, &(name->size), sizeof(int));
+	write_bytes(out, name->str, name->size);
+	return add_name(table, name);
+}
+
+/**
+ * @brief Writes a fixed size field of a command log.
+ *
+ * @param out Output writer.
+ * @param field Field to write.
+ * @param size Size of the field.
+ */
+void write_field(output_writer *out, void *field, int size) {
+	write_bytes(out, (char *)field, size);
+}
+
+/**
+ * @brief Writes a plate id, followed by the plate itself if it is invalid.
+ *
+ * @param plate_id Plate id to write.
+ * @param license_plate License plate, padded with null bytes.
+ * @param out Output writer.
+ */
+void write_log_plate(
+	unsigned int plate_id, char *license_plate, output_writer *out
+) {
+	write_field(out, &plate_id, sizeof(unsigned int));
+	if (plate_id == INVALID_PLATE) {
+		write_bytes(out, license_plate, LICENSE_PLATE_SIZE);
+	}
+}
+
+/**
+ * @brief Writes a stamp as its minutes and whether it is a valid date.
+ *
+ * Valid dates are rebuilt from their minutes, invalid ones are only ever
+ * rejected and need nothing else.
+ *
+ * @param timestamp Stamp to write.
+ * @param out Output writer.
+ */
+void write_log_stamp(date *timestamp, output_writer *out) {
+	write_field(out, &(timestamp->total_mins), sizeof(long int));
+	write_char(out, is_valid_date(timestamp));
+}
+
+/**
+ * @brief Replays the command log of the input.
+ *
+ * @param system System details structure.
+ * @return SUCCESSFUL after a 'q' record, UNEXPECTED_INPUT if the log ends
+ * without one, and UNEXPECTED if the log is malformed.
+ */
+error_codes replay_log(sys *system) {
+	name_table table;
+	char *bytes;
+	error_codes result = SUCCESSFUL;
+
+	bytes = next_bytes(&(system->input), LOG_MAGIC_SIZE);
+	if (bytes == NULL || memcmp(bytes, LOG_MAGIC, LOG_MAGIC_SIZE) != 0) {
+		return UNEXPECTED;
+	}
+
+	init_name_table(&table);
+	while ((bytes = next_bytes(&(system->input), 1)) != NULL) {
+		result = replay_record(*bytes, system, &table);
+		if (result == SUCCESSFUL_EXIT || result == UNEXPECTED) break;
+		reclaim_parks(&system->parks, &system->vehicles, &system->pools);
+	}
+	free_name_table(&table);
+
+	if (bytes == NULL) return UNEXPECTED_INPUT;
+	return (result == SUCCESSFUL_EXIT) ? SUCCESSFUL : UNEXPECTED;
+}
+
+/**
+ * @brief Replays a single record of a command log.
+ *
+ * @param opcode Opcode of the record, already read.
+ * @param system System details structure.
+ * @param table Names defined so far.
+ * @return Result of the command, SUCCESSFUL_EXIT for the 'q' record and
+ * UNEXPECTED if the record is malformed.
+ */
+error_codes replay_record(char opcode, sys *system, name_table *table) {
+	switch (opcode) {
+	case DEFINE_NAME:
+		return replay_name(system, table);
+	case LIST_PARKS:
+		show_parks(&(system->parks), &(system->out));
+		return SUCCESSFUL;
+	case COMMAND_EXIT:
+		return SUCCESSFUL_EXIT;
+	case CREATE_OR_VIEW:
+		return replay_p(system, table);
+	case ADD_VEHICLE:
+		return replay_e(system, table);
+	case REMOVE_VEHICLE:
+		return replay_s(system, table);
+	case VIEW_VEHICLE:
+		return replay_v(system);
+	case PARK_BILLING:
+		return replay_f(system, table);
+	case REMOVE_PARK:
+		return replay_r(system, table);
+	case SET_TARIFF:
+		return replay_t(system, table);
+	default:
+		return UNEXPECTED;
+	}
+}
+
+/**
+ * @brief Replays the definition of a park name.
+ *
+ * The park of the name is only searched for here, the records that follow
+ * find it by the id of its name.
+ *
+ * @param system System details structure.
+ * @param table Names defined so far.
+ * @return SUCCESSFUL if the name was defined, UNEXPECTED if malformed.
+ */
+error_codes replay_name(sys *system, name_table *table) {
+	input_reader *in = &(system->input);
+	name_view name;
+	int id;
+
+	if (!read_field(in, &(name.size), sizeof(int))) return UNEXPECTED;
+	if (name.size < 0 || name.size > MAX_LINE_BUFF) return UNEXPECTED;
+
+	name.str = next_bytes(in, name.size);
+	if (name.str == NULL) return UNEXPECTED;
+
+	id = add_name(table, &name);
+	table->parks[id] = find_park(&(table->names[id]), &(system->parks));
+	return SUCCESSFUL;
+}
+
+/**
+ * @brief Replays the creation of a park.
+ *
+ * @param system System details structure.
+ * @param table Names defined so far, the new park is set as its name's.
+ * @return Result of the command, UNEXPECTED if the record is malformed.
+ */
+error_codes replay_p(sys *system, name_table *table) {
+	p_args args = {.error = {NO_ERROR, NULL, 0}};
+	input_reader *in = &(system->input);
+	error_codes result;
+	int id;
+
+	if (!read_name_id(in, table, &id) ||
+		!read_field(in, &(args.capacity), sizeof(int)) ||
+		!read_field(in, &(args.first_value), sizeof(money)) ||
+		!read_field(in, &(args.value), sizeof(money)) ||
+		!read_field(in, &(args.day_value), sizeof(money))) {
+		return UNEXPECTED;
+	}
+
+	args.name = table->names[id];
+	result = execute_p(&args, &(system->parks), &(system->out));
+	if (result == SUCCESSFUL) table->parks[id] = system->parks.last;
+	return result;
+}
+
+/**
+ * @brief Replays the entrance of a vehicle.
+ *
+ * @param system System details structure.
+ * @param table Names defined so far.
+ * @return Result of the command, UNEXPECTED if the record is malformed.
+ */
+error_codes replay_e(sys *system, name_table *table) {
+	e_args args = {.error = {NO_ERROR, NULL, 0}};
+	input_reader *in = &(system->input);
+	int id;
+
+	if (!read_name_id(in, table, &id) ||
+		!read_log_plate(in, &(args.plate_id), args.license_plate) ||
+		!read_log_stamp(in, &(args.timestamp))) {
+		return UNEXPECTED;
+	}
+
+	args.name = table->names[id];
+	args.park = table->parks[id];
+	return execute_e(&args, system);
+}
+
+/**
+ * @brief Replays the exit of a vehicle.
+ *
+ * @param system System details structure.
+ * @param table Names defined so far.
+ * @return Result of the command, UNEXPECTED if the record is malformed.
+ */
+error_codes replay_s(sys *system, name_table *table) {
+	s_args args = {.error = {NO_ERROR, NULL, 0}};
+	input_reader *in = &(system->input);
+	int id;
+
+	if (!read_name_id(in, table, &id) ||
+		!read_log_plate(in, &(args.plate_id), args.license_plate) ||
+		!read_log_stamp(in, &(args.end))) {
+		return UNEXPECTED;
+	}
+
+	args.name = table->names[id];
+	args.park = table->parks[id];
+	return execute_s(&args, system);
+}
+
+/**
+ * @brief Replays the listing of the registries of a vehicle.
+ *
+ * @param system System details structure.
+ * @return Result of the command, UNEXPECTED if the record is malformed.
+ */
+error_codes replay_v(sys *system) {
+	v_args args = {.error = {NO_ERROR, NULL, 0}};
+
+	if (!read_log_plate(
+			&(system->input), &(args.plate_id), args.license_plate)) {
+		return UNEXPECTED;
+	}
+
+	return execute_v(&args, &(system->vehicles), &(system->out));
+}
+
+/**
+ * @brief Replays the billing listing of a park.
+ *
+ * @param system System details structure.
+ * @param table Names defined so far.
+ * @return Result of the command, UNEXPECTED if the record is malformed.
+ */
+error_codes replay_f(sys *system, name_table *table) {
+	f_args args = {.error = {NO_ERROR, NULL, 0}};
+	input_reader *in = &(system->input);
+	int id;
+
+	if (!read_name_id(in, table, &id) ||
+		!read_field(in, &(args.has_date), sizeof(bool))) {
+		return UNEXPECTED;
+	}
+	if (args.has_date && !read_log_stamp(in, &(args.timestamp))) {
+		return UNEXPECTED;
+	}
+
+	args.name = table->names[id];
+	args.park = table->parks[id];
+	return execute_f(&args, system);
+}
+
+/**
+ * @brief Replays the removal of a park.
+ *
+ * @param system System details structure.
+ * @param table Names defined so far, the removed park is unset from its
+ * name's.
+ * @return Result of the command, UNEXPECTED if the record is malformed.
+ */
+error_codes replay_r(sys *system, name_table *table) {
+	r_args args = {.error = {NO_ERROR, NULL, 0}};
+	error_codes result;
+	int id;
+
+	if (!read_name_id(&(system->input), table, &id)) return UNEXPECTED;
+
+	args.name = table->names[id];
+	args.park = table->parks[id];
+	result = execute_r(&args, system);
+	if (result == SUCCESSFUL) table->parks[id] = NULL;
+	return result;
+}
+
+/**
+ * @brief Replays a tariff band.
+ *
+ * @param system System details structure.
+ * @param table Names defined so far.
+ * @return Result of the command, UNEXPECTED if the record is malformed.
+ */
+error_codes replay_t(sys *system, name_table *table) {
+	t_args args = {.error = {NO_ERROR, NULL, 0}};
+	input_reader *in = &(system->input);
+	int id;
+
+	if (!read_name_id(in, table, &id) ||
+		!read_field(in, &(args.weekdays), sizeof(int)) ||
+		!read_field(in, &(args.start), sizeof(int)) ||
+		!read_field(in, &(args.end), sizeof(int)) ||
+		!read_field(in, &(args.value), sizeof(money))) {
+		return UNEXPECTED;
+	}
+
+	args.name = table->names[id];
+	args.park = table->parks[id];
+	return execute_t(&args, system);
+}
+
+/**
+ * @brief Reads a fixed size field of a command log.
+ *
+ * @param in Input reader.
+ * @param field Where the field is stored.
+ * @param size Size of the field.
+ * @return TRUE if the field was read, FALSE if the log ended before it.
+ */
+bool read_field(input_reader *in, void *field, int size) {
+	char *bytes = next_bytes(in, size);
+
+	if (bytes == NULL) return FALSE;
+	memcpy(field, bytes, size);
+	return TRUE;
+}
+
+/**
+ * @brief Reads the id of a park name.
+ *
+ * @param in Input reader.
+ * @param table Names defined so far.
+ * @param id Where the id is stored.
+ * @return TRUE if the id names a defined park name, FALSE otherwise.
+ */
+bool read_name_id(input_reader *in, name_table *table, int *id) {
+	if (!read_field(in, id, sizeof(int))) return FALSE;
+	return *id >= 0 && *id < table->name_num;
+}
+
+/**
+ * @brief Reads a plate id and the license plate it stands for.
+ *
+ * @param in Input reader.
+ * @param plate_id Where the plate id is stored.
+ * @param license_plate Where the license plate is stored.
+ * @return TRUE if the plate was read, FALSE if it is malformed.
+ */
+bool read_log_plate(
+	input_reader *in, unsigned int *plate_id, char *license_plate
+) {
+	if (!read_field(in, plate_id, sizeof(unsigned int))) return FALSE;
+	if (*plate_id > INVALID_PLATE) return FALSE;
+
+	if (*plate_id != INVALID_PLATE) {
+		decode_plate(*plate_id, license_plate);
+	} else if (!read_field(in, license_plate, LICENSE_PLATE_SIZE)) {
+		return FALSE;
+	}
+	license_plate[LICENSE_PLATE_SIZE] = '\0';
+	return TRUE;
+}
+
+/**
+ * @brief Reads a stamp as its minutes and whether it is a valid date.
+ *
+ * @param in Input reader.
+ * @param timestamp Where the stamp is stored, with no valid month if the
+ * stamp isn't a valid date.
+ * @return TRUE if the stamp was read, FALSE if the log ended before it.
+ */
+bool read_log_stamp(input_reader *in, date *timestamp) {
+	long int total_mins;
+	bool valid;
+
+	if (!read_field(in, &total_mins, sizeof(long int)) ||
+		!read_field(in, &valid, sizeof(bool))) {
+		return FALSE;
+	}
+
+	if (valid) {
+		minutes_to_date(total_mins, timestamp);
+	} else {
+		*timestamp = (date){total_mins, 0, 0, 0, 0, 0};
+	}
+	return TRUE;
+}
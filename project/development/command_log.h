@@ -0,0 +1,131 @@
+/**
+ * @file command_log.h
+ * @author Diogo Santos (ist1110262)
+ * @brief Declarations of the binary command log.
+ * @version 1
+ * @date 27-03-2024
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef COMMAND_LOG
+#define COMMAND_LOG
+
+#include "headers.h"
+
+/// @defgroup name_table_functions Name table related functions.
+/// @{
+
+/// Initializes an empty name table.
+void init_name_table(name_table *table);
+
+/// Frees the memory of a name table.
+void free_name_table(name_table *table);
+
+/// Finds the slot of a name, or the empty slot where it belongs.
+int *find_name_slot(name_table *table, name_view *name);
+
+/// Adds a copy of a name to a name table.
+int add_name(name_table *table, name_view *name);
+
+/// Doubles the slots of a name table.
+void grow_name_slots(name_table *table);
+
+/// @}
+
+/// @defgroup log_compile_functions Command log compilation functions.
+/// @{
+
+/// Compiles the text commands of the input into a command log.
+error_codes compile_log(input_reader *in, output_writer *out);
+
+/// Compiles a single text command into its log record.
+bool compile_command(char *command, name_table *table, output_writer *out);
+
+/// Compiles the creation of a park or the listing of all parks.
+void compile_park(char *buff, name_table *table, output_writer *out);
+
+/// Compiles a command that takes a park, a plate and a stamp.
+void compile_event(
+	char opcode, char *buff, name_table *table, output_writer *out
+);
+
+/// Compiles a billing listing.
+void compile_billing(char *buff, name_table *table, output_writer *out);
+
+/// Compiles a listing of the registries of a vehicle.
+void compile_vehicle(char *buff, output_writer *out);
+
+/// Compiles the removal of a park.
+void compile_removal(char *buff, name_table *table, output_writer *out);
+
+/// Compiles a tariff band.
+void compile_band(char *buff, name_table *table, output_writer *out);
+
+/// Gets the id of a park name, defining the name on first use.
+int intern_name(name_view *name, name_table *table, output_writer *out);
+
+/// Writes a fixed size field of a command log.
+void write_field(output_writer *out, void *field, int size);
+
+/// Writes a plate id, followed by the plate itself if it is invalid.
+void write_log_plate(
+	unsigned int plate_id, char *license_plate, output_writer *out
+);
+
+/// Writes a stamp as its minutes and whether it is a valid date.
+void write_log_stamp(date *timestamp, output_writer *out);
+
+/// @}
+
+/// @defgroup log_replay_functions Command log replay functions.
+/// @{
+
+/// Replays the command log of the input.
+error_codes replay_log(sys *system);
+
+/// Replays a single record of a command log.
+error_codes replay_record(char opcode, sys *system, name_table *table);
+
+/// Replays the definition of a park name.
+error_codes replay_name(sys *system, name_table *table);
+
+/// Replays the creation of a park.
+error_codes replay_p(sys *system, name_table *table);
+
+/// Replays the entrance of a vehicle.
+error_codes replay_e(sys *system, name_table *table);
+
+/// Replays the exit of a vehicle.
+error_codes replay_s(sys *system, name_table *table);
+
+/// Replays the listing of the registries of a vehicle.
+error_codes replay_v(sys *system);
+
+/// Replays the billing listing of a park.
+error_codes replay_f(sys *system, name_table *table);
+
+/// Replays the removal of a park.
+error_codes replay_r(sys *system, name_table *table);
+
+/// Replays a tariff band.
+error_codes replay_t(sys *system, name_table *table);
+
+/// Reads a fixed size field of a command log.
+bool read_field(input_reader *in, void *field, int size);
+
+/// Reads the id of a park name.
+bool read_name_id(input_reader *in, name_table *table, int *id);
+
+/// Reads a plate id and the license plate it stands for.
+bool read_log_plate(
+	input_reader *in, unsigned int *plate_id, char *license_plate
+);
+
+/// Reads a stamp as its minutes and whether it is a valid date.
+bool read_log_stamp(input_reader *in, date *timestamp);
+
+/// @}
+
+#endif
@@ -11,50 +11,78 @@
 
 #include "headers.h"
 
+// Messages of the command errors, after their subject if they have one.
+const char *error_messages[] = {
+	"", "parking already exists.\n", "invalid capacity.\n", "invalid cost.\n",
+	"too many parks.\n", "no such parking.\n", "parking is full.\n",
+	"invalid licence plate.\n", "invalid vehicle entry.\n",
+	"invalid vehicle exit.\n", "no entries found in any parking.\n",
+	"invalid date.\n", "invalid tariff band.\n"};
+
 /**
  * @brief Creates a new parking lot or lists existing ones.
  *
  * @param buff Input buffer with park details.
  * @param parks Park index.
+ * @param out Output writer.
  * @return error_codes: SUCCESSFUL if park added, UNEXPECTED_INPUT if error.
  */
-error_codes run_p(char *buff, park_index *parks) {
-	p_args args = {.err = {}};
+error_codes run_p(char *buff, park_index *parks, output_writer *out) {
+	p_args args = {.error = {NO_ERROR, NULL, 0}};
 
 	// No arguments found.
 	if (*buff == '\0') {
-		show_parks(parks);
+		show_parks(parks, out);
 		return SUCCESSFUL;
 	}
 
-	// Get the necessary arguments.
-	args.name_size = str_size(&buff);
-	args.name = parse_string(buff, &buff, &(args.name_size));
-	args.capacity = strtol(buff, &buff, 0);
-	args.first_value = strtof(buff, &buff);
-	args.value = strtof(buff, &buff);
-	args.day_value = strtof(buff, &buff);
+	parse_p_args(buff, &args);
+	return execute_p(&args, parks, out);
+}
 
+/**
+ * @brief Parses the arguments of a new parking lot.
+ *
+ * @param buff Input buffer with park details.
+ * @param args Arguments for the 'p' command.
+ */
+void parse_p_args(char *buff, p_args *args) {
+	buff = parse_name(buff, &(args->name));
+	args->capacity = strtol(buff, &buff, 0);
+	args->first_value = parse_money(buff, &buff);
+	args->value = parse_money(buff, &buff);
+	args->day_value = parse_money(buff, &buff);
+}
+
+/**
+ * @brief Creates a new parking lot from parsed arguments.
+ *
+ * @param args Arguments for the 'p' command.
+ * @param parks Park index.
+ * @param out Output writer.
+ * @return error_codes: SUCCESSFUL if park added, UNEXPECTED_INPUT if error.
+ */
+error_codes execute_p(p_args *args, park_index *parks, output_writer *out) {
 	// Error checking.
-	if (find_park(args.name, hash(args.name), parks) != NULL) {
-		sprintf(args.err, "%s: parking already exists.\n", args.name);
-	} else if (args.capacity <= 0) {
-		sprintf(args.err, "%i: invalid capacity.\n", args.capacity);
-	} else if (args.first_value <= 0
-				|| args.first_value > args.value 
-				|| args.value > args.day_value) {
-		sprintf(args.err, "invalid cost.\n");
-	} else if (parks->park_num == MAX_PARKS) {
-		sprintf(args.err, "too many parks.\n");
+	if (find_park(&(args->name), parks) != NULL) {
+		args->error = (command_error){PARK_EXISTS, args->name.str, 0};
+	} else if (args->capacity <= 0) {
+		args->error = (command_error){BAD_CAPACITY, NULL, args->capacity};
+	} else if (args->first_value <= 0
+				|| args->first_value > args->value 
+				|| args->value > args->day_value) {
+		args->error = (command_error){BAD_COST, NULL, 0};
+	} else if (parks->park_num >= parks->max_parks) {
+		args->error = (command_error){TOO_MANY_PARKS, NULL, 0};
 	}
 
-	if (args.err[0] != '\0') {
-		printf("%s", args.err);
+	if (args->error.code != NO_ERROR) {
+		report_error(&(args->error), out);
 		return UNEXPECTED_INPUT;
 	}
 
 	// Execute the command.
-	add_park(&args, parks);
+	add_park(args, parks);
 
 	return SUCCESSFUL;
 }
@@ -68,32 +96,55 @@ error_codes run_p(char *buff, park_index *parks) {
  * error.
  */
 error_codes run_e(char *buff, sys *system) {
-	e_args args = {.err = {}};
-
-	// Get the necessary arguments.
-	args.name_size = str_size(&buff);
-	args.name = parse_string(buff, &buff, &args.name_size);
-	buff = parse_license_plate(buff, args.license_plate);
-	buff = parse_date(buff, &(args.timestamp));
-	buff = parse_time(buff, &(args.timestamp));
-	args.timestamp.total_mins = date_to_minutes(&(args.timestamp));
-	args.park = find_park(args.name, hash(args.name), &(system->parks));
-	args.vehicle = find_vehicle(args.license_plate, &(system->vehicles));
+	e_args args = {.error = {NO_ERROR, NULL, 0}};
+
+	parse_e_args(buff, &args);
+	args.park = find_park(&(args.name), &(system->parks));
+	return execute_e(&args, system);
+}
+
+/**
+ * @brief Parses the arguments of a vehicle entry.
+ *
+ * @param buff Input buffer with vehicle details.
+ * @param args Arguments for the 'e' command.
+ */
+void parse_e_args(char *buff, e_args *args) {
+	buff = parse_name(buff, &(args->name));
+	buff = parse_license_plate(buff, args->license_plate, &(args->plate_id));
+	parse_stamp(buff, &(args->timestamp));
+}
+
+/**
+ * @brief Enters vehicle into park from parsed arguments.
+ *
+ * @param args Arguments for the 'e' command, with its park found.
+ * @param system System details structure.
+ * @return error_codes: SUCCESSFUL if entrance registered, UNEXPECTED_INPUT if
+ * error, UNEXPECTED if the vehicle can't be allocated.
+ */
+error_codes execute_e(e_args *args, sys *system) {
+	args->vehicle = find_vehicle(args->plate_id, &(system->vehicles));
 
 	// Error checking.
-	run_e_errochecking(&args, system);
-	if (args.err[0] != '\0') {
-		printf("%s", args.err);
-		free(args.name);
+	run_e_errochecking(args, system);
+	if (args->error.code != NO_ERROR) {
+		report_error(&(args->error), &(system->out));
 		return UNEXPECTED_INPUT;
 	}
 
-	// Execute the command.
-	system->sysdate = args.timestamp;
-	register_entrance(&args, &(system->vehicles));
-	printf("%s %i\n", args.name, (args.park)->free_spaces);
+	// Execute the command, creating the vehicle if it doesnt exist.
+	if (args->vehicle == NULL) {
+		args->vehicle = add_vehicle(args->plate_id, &(system->vehicles));
+		if (args->vehicle == NULL) return UNEXPECTED;
+	}
+	system->sysdate = args->timestamp.total_mins;
+	register_entrance(args, &(system->pools));
+	write_str(&(system->out), args->name.str);
+	write_char(&(system->out), ' ');
+	write_int(&(system->out), args->park->free_spaces);
+	write_char(&(system->out), '\n');
 
-	free(args.name);
 	return SUCCESSFUL;
 }
 
@@ -104,34 +155,31 @@ error_codes run_e(char *buff, sys *system) {
  * @param system System details structure.
  */
 void run_e_errochecking(e_args *args, sys *system) {
-	registry *last_vehicle_reg;
+	stay *last_stay;
 
 	if (args->park == NULL) {
-		sprintf(args->err, "%s: no such parking.\n", args->name);
+		args->error = (command_error){NO_SUCH_PARK, args->name.str, 0};
 		return;
 	} else if (args->park->free_spaces == 0) {
-		sprintf(args->err, "%s: parking is full.\n", args->name);
+		args->error = (command_error){PARK_FULL, args->name.str, 0};
 		return;
-	} else if (!is_licence_plate(args->license_plate)) {
-		sprintf(
-			args->err, "%s: invalid licence plate.\n", args->license_plate
-		);
+	} else if (args->plate_id == INVALID_PLATE) {
+		args->error = (command_error){BAD_PLATE, args->license_plate, 0};
 		return;
 	}
 
 	if (args->vehicle != NULL) {
-		last_vehicle_reg = args->vehicle->last_reg;
-		if (last_vehicle_reg == NULL ||
-			(last_vehicle_reg->type != EXIT &&
-				last_vehicle_reg->registration->enter.park_ptr != NULL)) {
-			sprintf(
-				args->err, "%s: invalid vehicle entry.\n", args->license_plate
-			);
+		last_stay = args->vehicle->last_stay;
+		if (last_stay != NULL && last_stay->exit == OPEN_STAY &&
+			stay_park(last_stay) != NULL) {
+			args->error = (command_error){BAD_ENTRY, args->license_plate, 0};
 			return;
 		}
 	}
 
-	verify_date_registry(&(system->sysdate), args->err, &(args->timestamp));
+	verify_date_registry(
+		system->sysdate, &(args->error), &(args->timestamp)
+	);
 }
 
 /**
@@ -143,36 +191,11 @@ void run_e_errochecking(e_args *args, sys *system) {
  * error.
  */
 error_codes run_s(char *buff, sys *system) {
-	s_args args = {.err = {}};
+	s_args args = {.error = {NO_ERROR, NULL, 0}};
 
-	// Get the necessary arguments.
-	run_s_args(&buff, &args, &(system->parks));
-	args.vehicle = find_vehicle(args.license_plate, &(system->vehicles));
-
-	// Error checking.
-	run_s_errochecking(&args, &(system->sysdate));
-	if (args.err[0] != '\0') {
-		printf("%s", args.err);
-		free(args.name);
-		return UNEXPECTED_INPUT;
-	}
-
-	// Execute the command.
-	args.start = args.vehicle->last_reg->registration->enter.timestamp;
-	args.cost = calculate_cost(&args.start, &args.end, args.park);
-	system->sysdate = args.end;
-	register_exit(&args);
-
-	printf(
-		"%s %02d-%02d-%04d %02d:%02d %02d-%02d-%04d %02d:%02d %.2f\n",
-		args.license_plate, args.start.days, args.start.months,
-		args.start.years, args.start.hours, args.start.minutes, args.end.days,
-		args.end.months, args.end.years, args.end.hours, args.end.minutes,
-		args.cost
-	);
-
-	free(args.name);
-	return SUCCESSFUL;
+	run_s_args(buff, &args);
+	args.park = find_park(&(args.name), &(system->parks));
+	return execute_s(&args, system);
 }
 
 /**
@@ -180,17 +203,49 @@ error_codes run_s(char *buff, sys *system) {
  *
  * @param buff Input buffer with vehicle & park details.
  * @param args Arguments for the 's' command.
- * @param parks Park index.
  */
-void run_s_args(char **buff, s_args *args, park_index *parks) {
-	int name_size;
-	name_size = str_size(buff);
-	args->name = parse_string(*buff, buff, &name_size);
-	*buff = parse_license_plate(*buff, args->license_plate);
-	*buff = parse_date(*buff, &(args->end));
-	*buff = parse_time(*buff, &(args->end));
-	args->end.total_mins = date_to_minutes(&(args->end));
-	args->park = find_park(args->name, hash(args->name), parks);
+void run_s_args(char *buff, s_args *args) {
+	buff = parse_name(buff, &(args->name));
+	buff = parse_license_plate(buff, args->license_plate, &(args->plate_id));
+	parse_stamp(buff, &(args->end));
+}
+
+/**
+ * @brief Registers vehicle exit from park from parsed arguments.
+ *
+ * @param args Arguments for the 's' command, with its park found.
+ * @param system System details structure.
+ * @return error_codes: SUCCESSFUL if exit registered, UNEXPECTED_INPUT if
+ * error.
+ */
+error_codes execute_s(s_args *args, sys *system) {
+	output_writer *out = &(system->out);
+
+	args->vehicle = find_vehicle(args->plate_id, &(system->vehicles));
+
+	// Error checking.
+	run_s_errochecking(args, system->sysdate);
+	if (args->error.code != NO_ERROR) {
+		report_error(&(args->error), out);
+		return UNEXPECTED_INPUT;
+	}
+
+	// Execute the command.
+	args->start = args->vehicle->last_stay->entry;
+	args->cost = calculate_cost(args->start, args->end.total_mins, args->park);
+	system->sysdate = args->end.total_mins;
+	register_exit(args);
+
+	write_str(out, args->license_plate);
+	write_char(out, ' ');
+	write_stamp(out, args->start);
+	write_char(out, ' ');
+	write_stamp(out, args->end.total_mins);
+	write_char(out, ' ');
+	write_money(out, args->cost);
+	write_char(out, '\n');
+
+	return SUCCESSFUL;
 }
 
 /**
@@ -199,32 +254,30 @@ void run_s_args(char **buff, s_args *args, park_index *parks) {
  * @param args Arguments for the 's' command.
  * @param sysdate System date.
  */
-void run_s_errochecking(s_args *args, date *sysdate) {
-	registry *last_vehicle_reg;
+void run_s_errochecking(s_args *args, long int sysdate) {
+	stay *last_stay;
 
 	if (args->park == NULL) {
-		sprintf(args->err, "%s: no such parking.\n", args->name);
+		args->error = (command_error){NO_SUCH_PARK, args->name.str, 0};
 		return;
-	} else if (!is_licence_plate(args->license_plate)) {
-		sprintf(
-			args->err, "%s: invalid licence plate.\n", args->license_plate
-		);
+	} else if (args->plate_id == INVALID_PLATE) {
+		args->error = (command_error){BAD_PLATE, args->license_plate, 0};
 		return;
 	}
 
-	if (args->vehicle != NULL) {
-		last_vehicle_reg = args->vehicle->last_reg;
+	if (args->vehicle != NULL && args->vehicle->last_stay != NULL) {
+		last_stay = args->vehicle->last_stay;
 	} else {
-		sprintf(args->err, "%s: invalid vehicle exit.\n", args->license_plate);
+		args->error = (command_error){BAD_EXIT, args->license_plate, 0};
 		return;
 	}
 
-	if (last_vehicle_reg == NULL || last_vehicle_reg->type != ENTER) {
-		sprintf(args->err, "%s: invalid vehicle exit.\n", args->license_plate);
-	} else if (last_vehicle_reg->registration->enter.park_ptr != args->park) {
-		sprintf(args->err, "%s: invalid vehicle exit.\n", args->license_plate);
+	if (last_stay->exit != OPEN_STAY) {
+		args->error = (command_error){BAD_EXIT, args->license_plate, 0};
+	} else if (stay_park(last_stay) != args->park) {
+		args->error = (command_error){BAD_EXIT, args->license_plate, 0};
 	} else {
-		verify_date_registry(sysdate, args->err, &(args->end));
+		verify_date_registry(sysdate, &(args->error), &(args->end));
 	}
 }
 
@@ -233,33 +286,41 @@ void run_s_errochecking(s_args *args, date *sysdate) {
  *
  * @param buff Input buffer with vehicle details.
  * @param vehicles Vehicle index.
+ * @param out Output writer.
  * @return error_codes: SUCCESSFUL on registries listed, UNEXPECTED_INPUT if
  * error.
  */
-error_codes run_v(char *buff, vehicle_index *vehicles) {
-	v_args args = {
-		.err = {}, .non_null_regs = malloc(sizeof(registry *) * CHUNK_SIZE)};
+error_codes run_v(char *buff, vehicle_index *vehicles, output_writer *out) {
+	v_args args = {.error = {NO_ERROR, NULL, 0}};
 
-	// Get the necessary arguments.
-	parse_license_plate(buff, args.license_plate);
-	args.vehicle = find_vehicle(args.license_plate, vehicles);
+	parse_license_plate(buff, args.license_plate, &(args.plate_id));
+	return execute_v(&args, vehicles, out);
+}
+
+/**
+ * @brief Shows all registries for a vehicle from parsed arguments.
+ *
+ * @param args Arguments for the 'v' command.
+ * @param vehicles Vehicle index.
+ * @param out Output writer.
+ * @return error_codes: SUCCESSFUL on registries listed, UNEXPECTED_INPUT if
+ * error.
+ */
+error_codes execute_v(
+	v_args *args, vehicle_index *vehicles, output_writer *out
+) {
+	args->vehicle = find_vehicle(args->plate_id, vehicles);
 
 	// Error checking.
-	run_v_errorchecking(&args);
-	if (args.err[0] != '\0') {
-		printf("%s", args.err);
-		free(args.non_null_regs);
+	run_v_errorchecking(args);
+	if (args->error.code != NO_ERROR) {
+		report_error(&(args->error), out);
 		return UNEXPECTED_INPUT;
 	}
 
 	// Execute the command.
-	merge_sort(
-		(void **)args.non_null_regs, 0, args.count - 1,
-		(comp_func)compare_regs_park
-	);
-	show_all_regs(args.non_null_regs, args.vehicle->last_reg, &(args.count));
+	show_all_regs(args->vehicle, out);
 
-	free(args.non_null_regs);
 	return SUCCESSFUL;
 }
 
@@ -269,24 +330,10 @@ error_codes run_v(char *buff, vehicle_index *vehicles) {
  * @param args Arguments for the 'v' command.
  */
 void run_v_errorchecking(v_args *args) {
-	if (!is_licence_plate(args->license_plate)) {
-		sprintf(
-			args->err, "%s: invalid licence plate.\n", args->license_plate
-		);
-	} else if (args->vehicle == NULL) {
-		sprintf(
-			args->err, "%s: no entries found in any parking.\n",
-			args->license_plate
-		);
-	} else {
-		args->count = get_non_null_registries(
-			args->vehicle->registries, &(args->non_null_regs)
-		);
-		if (args->count == 0)
-			sprintf(
-				args->err, "%s: no entries found in any parking.\n",
-				args->license_plate
-			);
+	if (args->plate_id == INVALID_PLATE) {
+		args->error = (command_error){BAD_PLATE, args->license_plate, 0};
+	} else if (args->vehicle == NULL || !has_live_history(args->vehicle)) {
+		args->error = (command_error){NO_ENTRIES, args->license_plate, 0};
 	}
 }
 
@@ -299,42 +346,61 @@ void run_v_errorchecking(v_args *args) {
  * error.
  */
 error_codes run_f(char *buff, sys *system) {
-	f_args args = {.err = {}, .timestamp = {.minutes = 0, .hours = 0}};
+	f_args args = {
+		.error = {NO_ERROR, NULL, 0}, .timestamp = {.minutes = 0, .hours = 0}};
 
-	// Get the necessary arguments.
-	args.name_size = str_size(&buff);
-	args.name = parse_string(buff, &buff, &(args.name_size));
-	args.park = find_park(args.name, hash(args.name), &(system->parks));
-	buff = remove_whitespaces(buff);
+	parse_f_args(buff, &args);
+	args.park = find_park(&(args.name), &(system->parks));
+	return execute_f(&args, system);
+}
 
-	if (args.park == NULL) {
-		printf("%s: no such parking.\n", args.name);
-		free(args.name);
-		return UNEXPECTED_INPUT;
-	}
+/**
+ * @brief Parses the arguments of a billing listing.
+ *
+ * @param buff Input buffer with park details.
+ * @param args Arguments for the 'f' command, with a zeroed time.
+ */
+void parse_f_args(char *buff, f_args *args) {
+	buff = parse_name(buff, &(args->name));
+	buff = remove_whitespaces(buff);
 
 	// No more arguments found.
-	if (*buff == '\0') {
-		show_billing(args.park);
-		free(args.name);
-		return SUCCESSFUL;
-	}
+	args->has_date = (*buff != '\0');
+	if (!args->has_date) return;
 
-	buff = parse_date(buff, &args.timestamp);
-	args.timestamp.total_mins = date_to_minutes(&args.timestamp);
+	parse_date(buff, &(args->timestamp));
+	args->timestamp.total_mins = date_to_minutes(&(args->timestamp));
+}
 
+/**
+ * @brief Shows billing for a park from parsed arguments.
+ *
+ * @param args Arguments for the 'f' command, with its park found.
+ * @param system System details structure.
+ * @return error_codes: SUCCESSFUL on billing listed, UNEXPECTED_INPUT if
+ * error.
+ */
+error_codes execute_f(f_args *args, sys *system) {
 	// Error checking.
-	if (!is_valid_date(&(args.timestamp)) ||
-		args.timestamp.total_mins > system->sysdate.total_mins) {
-		printf("invalid date.\n");
-		free(args.name);
+	if (args->park == NULL) {
+		args->error = (command_error){NO_SUCH_PARK, args->name.str, 0};
+	} else if (args->has_date && (!is_valid_date(&(args->timestamp)) ||
+			args->timestamp.total_mins > system->sysdate)) {
+		args->error = (command_error){BAD_DATE, NULL, 0};
+	}
+
+	if (args->error.code != NO_ERROR) {
+		report_error(&(args->error), &(system->out));
 		return UNEXPECTED_INPUT;
 	}
 
 	// Execute the command.
-	show_billing_day(args.park, &args.timestamp);
+	if (args->has_date) {
+		show_billing_day(args->park, &(args->timestamp), &(system->out));
+	} else {
+		show_billing(args->park, &(system->out));
+	}
 
-	free(args.name);
 	return SUCCESSFUL;
 }
 
@@ -342,35 +408,97 @@ error_codes run_f(char *buff, sys *system) {
  * @brief Removes a park and lists remaining parks.
  *
  * @param buff Input buffer with park details.
- * @param parks Park index.
+ * @param system System details structure.
  * @return error_codes: SUCCESSFUL on park removed, UNEXPECTED_INPUT if error.
  */
-error_codes run_r(char *buff, park_index *parks) {
-	r_args args = {.names = malloc(sizeof(char *) * CHUNK_SIZE)};
+error_codes run_r(char *buff, sys *system) {
+	r_args args = {.error = {NO_ERROR, NULL, 0}};
+
+	parse_name(buff, &(args.name));
+	args.park = find_park(&(args.name), &(system->parks));
+	return execute_r(&args, system);
+}
 
-	// Get the necessary arguments.
-	args.name_size = str_size(&buff);
-	args.name = parse_string(buff, &buff, &args.name_size);
-	args.park = find_park(args.name, hash(args.name), parks);
+/**
+ * @brief Removes a park from parsed arguments and lists remaining parks.
+ *
+ * @param args Arguments for the 'r' command, with its park found.
+ * @param system System details structure.
+ * @return error_codes: SUCCESSFUL on park removed, UNEXPECTED_INPUT if error.
+ */
+error_codes execute_r(r_args *args, sys *system) {
+	park_index *parks = &(system->parks);
 
 	// Error checking.
-	if (args.park == NULL) {
-		printf("%s: no such parking.\n", args.name);
-		free(args.name);
-		free(args.names);
+	if (args->park == NULL) {
+		args->error = (command_error){NO_SUCH_PARK, args->name.str, 0};
+		report_error(&(args->error), &(system->out));
 		return UNEXPECTED_INPUT;
 	}
 
 	// Execute the command.
-	remove_park(args.park, parks);
-	args.count = get_park_names(parks, &args.names);
-	merge_sort((void **)args.names, 0, args.count - 1, (comp_func)strcmp);
-	for (args.i = 0; args.i < args.count; args.i++) {
-		printf("%s\n", args.names[args.i]);
+	remove_park(args->park, parks);
+	show_park_names(parks->root, &(system->out));
+
+	return SUCCESSFUL;
+}
+
+/**
+ * @brief Adds a tariff band to the schedule of a park.
+ *
+ * @param buff Input buffer with the band details.
+ * @param system System details structure.
+ * @return error_codes: SUCCESSFUL on band added, UNEXPECTED_INPUT if error.
+ */
+error_codes run_t(char *buff, sys *system) {
+	t_args args = {.error = {NO_ERROR, NULL, 0}};
+
+	parse_t_args(buff, &args);
+	args.park = find_park(&(args.name), &(system->parks));
+	return execute_t(&args, system);
+}
+
+/**
+ * @brief Parses the arguments of a tariff band.
+ *
+ * @param buff Input buffer with the band details.
+ * @param args Arguments for the 't' command.
+ */
+void parse_t_args(char *buff, t_args *args) {
+	buff = parse_name(buff, &(args->name));
+	buff = parse_weekdays(buff, &(args->weekdays));
+	buff = parse_clock(buff, &(args->start));
+	buff = parse_clock(buff, &(args->end));
+	args->value = parse_money(buff, &buff);
+}
+
+/**
+ * @brief Adds a tariff band to the schedule of a park from parsed arguments.
+ *
+ * @param args Arguments for the 't' command, with its park found.
+ * @param system System details structure.
+ * @return error_codes: SUCCESSFUL on band added, UNEXPECTED_INPUT if error.
+ */
+error_codes execute_t(t_args *args, sys *system) {
+	// Error checking.
+	if (args->park == NULL) {
+		args->error = (command_error){NO_SUCH_PARK, args->name.str, 0};
+	} else if (args->weekdays == 0 || args->start < 0 ||
+			args->end <= args->start || args->end > MINS_PER_DAY) {
+		args->error = (command_error){BAD_BAND, NULL, 0};
+	} else if (args->value < args->park->tariff[1] ||
+			args->value > args->park->day_value) {
+		args->error = (command_error){BAD_COST, NULL, 0};
+	}
+
+	if (args->error.code != NO_ERROR) {
+		report_error(&(args->error), &(system->out));
+		return UNEXPECTED_INPUT;
 	}
 
-	free(args.name);
-	free(args.names);
+	// Execute the command.
+	add_band(args->park, args);
+
 	return SUCCESSFUL;
 }
 
@@ -378,12 +506,30 @@ error_codes run_r(char *buff, park_index *parks) {
  * @brief Verifies if a date of a registry is valid and not in the past.
  *
  * @param sysdate System date.
- * @param err Error message.
+ * @param error Error of the command, set if the date is invalid.
  * @param timestamp Date to verify.
  */
-void verify_date_registry(date *sysdate, char *err, date *timestamp) {
-	if (!is_valid_date(timestamp) ||
-		sysdate->total_mins > timestamp->total_mins) {
-		sprintf(err, "invalid date.\n");
+void verify_date_registry(
+	long int sysdate, command_error *error, date *timestamp
+) {
+	if (!is_valid_date(timestamp) || sysdate > timestamp->total_mins) {
+		*error = (command_error){BAD_DATE, NULL, 0};
+	}
+}
+
+/**
+ * @brief Writes the message of a command error.
+ *
+ * @param error Error to report.
+ * @param out Output writer.
+ */
+void report_error(command_error *error, output_writer *out) {
+	if (error->code == BAD_CAPACITY) {
+		write_int(out, error->value);
+		write_str(out, ": ");
+	} else if (error->subject != NULL) {
+		write_str(out, error->subject);
+		write_str(out, ": ");
 	}
+	write_str(out, error_messages[error->code]);
 }
\ No newline at end of file
@@ -18,25 +18,65 @@
 /// @{
 
 /// Creates a new parking lot or lists existing ones.
-error_codes run_p(char *buff, park_index *parks);
+error_codes run_p(char *buff, park_index *parks, output_writer *out);
+
+/// Parses the arguments of a new parking lot.
+void parse_p_args(char *buff, p_args *args);
+
+/// Creates a new parking lot from parsed arguments.
+error_codes execute_p(p_args *args, park_index *parks, output_writer *out);
 
 /// Registers an entrance of a vehicle in a parking lot.
 error_codes run_e(char *buff, sys *system);
 
+/// Parses the arguments of an entrance.
+void parse_e_args(char *buff, e_args *args);
+
+/// Registers an entrance from parsed arguments.
+error_codes execute_e(e_args *args, sys *system);
+
 /// Registers an exit of a vehicle in a parking lot.
 error_codes run_s(char *buff, sys *system);
 
 /// Aux function to collect the args needed for exit.
-void run_s_args(char **buff, s_args *args, park_index *parks);
+void run_s_args(char *buff, s_args *args);
+
+/// Registers an exit from parsed arguments.
+error_codes execute_s(s_args *args, sys *system);
 
 /// Lists all the registries of a vehicle.
-error_codes run_v(char *buff, vehicle_index *vehicles);
+error_codes run_v(
+	char *buff, vehicle_index *vehicles, output_writer *out
+);
+
+/// Lists all the registries of a vehicle from parsed arguments.
+error_codes execute_v(
+	v_args *args, vehicle_index *vehicles, output_writer *out
+);
 
 /// List all the registries of a parking lot.
 error_codes run_f(char *buff, sys *system);
 
+/// Parses the arguments of a billing listing.
+void parse_f_args(char *buff, f_args *args);
+
+/// List the billing of a parking lot from parsed arguments.
+error_codes execute_f(f_args *args, sys *system);
+
 /// Deletes a parking lot.
-error_codes run_r(char *buff, park_index *parks);
+error_codes run_r(char *buff, sys *system);
+
+/// Deletes a parking lot from parsed arguments.
+error_codes execute_r(r_args *args, sys *system);
+
+/// Adds a tariff band to the schedule of a parking lot.
+error_codes run_t(char *buff, sys *system);
+
+/// Parses the arguments of a tariff band.
+void parse_t_args(char *buff, t_args *args);
+
+/// Adds a tariff band from parsed arguments.
+error_codes execute_t(t_args *args, sys *system);
 
 /// @}
 
@@ -47,13 +87,18 @@ error_codes run_r(char *buff, park_index *parks);
 void run_e_errochecking(e_args *buff, sys *system);
 
 /// Error checking for exits.
-void run_s_errochecking(s_args *args, date *sysdate);
+void run_s_errochecking(s_args *args, long int sysdate);
 
 /// Error checking for vehicle registries listing .
 void run_v_errorchecking(v_args *args);
 
 /// Aux date checking for registry validation.
-void verify_date_registry(date *sysdate, char *err, date *timestamp);
+void verify_date_registry(
+	long int sysdate, command_error *error, date *timestamp
+);
+
+/// Writes the message of a command error.
+void report_error(command_error *error, output_writer *out);
 
 /// @}
 
@@ -18,12 +18,53 @@
 /// Buffer size for reading input from the command line.
 #define MAX_LINE_BUFF 8192
 
+/// Size of the blocks read from the input, must exceed MAX_LINE_BUFF.
+#define INPUT_BLOCK_SIZE (1 << 16)
+
+/// Size of the buffer of the output writer.
+#define OUTPUT_BUFFER_SIZE (1 << 16)
+
+/// Enough characters for any long integer and its sign.
+#define MAX_NUMBER_SIZE 24
+
+/// Day cached by an output writer before any date is written.
+#define NO_CACHED_DAY -1
+
 /// Chunk size to allocate memory in most situations.
 #define CHUNK_SIZE 100
 
 /// Hash-map default size.
 #define HASH_SIZE 100
 
+/// Number of objects carved out of each slab.
+#define SLAB_OBJECTS 1024
+
+/// Load factor above which a hash-map is resized.
+#define MAX_LOAD_FACTOR 0.75
+
+/// Growth factor of hash-maps and dynamic arrays when resized.
+#define GROWTH_FACTOR 2
+
+/// @}
+
+/// @defgroup vehicle_index_constants Vehicle index related constants.
+/// @{
+
+/// Initial number of slots of the vehicle index, a power of two.
+#define VEHICLE_INDEX_SIZE 1024
+
+/// Load factor below which the vehicle index is shrunk.
+#define MIN_LOAD_FACTOR 0.25
+
+/// Multiplier spreading plate ids over the slots (golden ratio).
+#define PLATE_MULTIPLIER 0x9E3779B9U
+
+/// Number of bits of a hashed plate id.
+#define PLATE_HASH_BITS 32
+
+/// Plate id of an empty slot, which no valid plate has.
+#define EMPTY_SLOT PLATE_ID_LIMIT
+
 /// @}
 
 /// @defgroup command_constants Command related constants.
@@ -37,7 +78,8 @@ enum commands {
 	REMOVE_VEHICLE = 's',
 	VIEW_VEHICLE = 'v',
 	PARK_BILLING = 'f',
-	REMOVE_PARK = 'r'
+	REMOVE_PARK = 'r',
+	SET_TARIFF = 't'
 };
 
 /// @}
@@ -45,31 +87,211 @@ enum commands {
 /// @defgroup park_vehicle_constants Park & Vehicle related constants.
 /// @{
 
-/// Maximum number of parks.
-#define MAX_PARKS 20
+/// Default maximum number of parks, can be changed at startup.
+#define DEFAULT_MAX_PARKS 20
+
+/// Command line option to change the maximum number of parks.
+#define MAX_PARKS_OPTION "-p"
+
+/// Number of leading bytes of a park name packed into its name key.
+#define NAME_KEY_BYTES ((int)sizeof(unsigned long))
+
+/// Number of bits in a byte of a name key.
+#define BYTE_BITS 8
+
+/// Mask of the last byte of a name key.
+#define BYTE_MASK 0xFF
+
+/// Largest value of an int, the limit of the numbers given at startup.
+#define INT_LIMIT ((int)(~0U >> 1))
 
 /// Maximum size of License plates.
 #define LICENSE_PLATE_SIZE 8
 
+/// Number of pairs in a license plate.
+#define PLATE_PAIRS 3
+
+/// Distance between the start of two pairs in a license plate.
+#define PAIR_STRIDE 3
+
+/// Separator between the pairs of a license plate.
+#define PLATE_SEPARATOR '-'
+
+/// Number of letters a pair can be made of.
+#define PLATE_LETTERS 26
+
+/// Number of digits a pair can be made of.
+#define PLATE_DIGITS 10
+
+/// Number of distinct letter pairs, encoded first.
+#define LETTER_PAIRS (PLATE_LETTERS * PLATE_LETTERS)
+
+/// Number of distinct pairs, letter pairs followed by digit pairs.
+#define PAIR_VALUES (LETTER_PAIRS + PLATE_DIGITS * PLATE_DIGITS)
+
+/// Number of distinct plate ids, which all fit in 29 bits.
+#define PLATE_ID_LIMIT (PAIR_VALUES * PAIR_VALUES * PAIR_VALUES)
+
+/// Plate id of an invalid license plate.
+#define INVALID_PLATE PLATE_ID_LIMIT
+
 /// Maximum size of date.
 #define DATE_READ_SIZE 10
 
 /// Maximum size of hour.
 #define HOUR_READ_SIZE 5
 
+/// Maximum number of characters of a day, month, hour or minute.
+#define FIELD_DIGITS 2
+
+/// Maximum number of characters of a year.
+#define YEAR_DIGITS 4
+
+/// Separator between the day, month and year of a date.
+#define DATE_SEPARATOR '-'
+
+/// Separator between the hours and minutes of a time.
+#define TIME_SEPARATOR ':'
+
+/// Size of a date followed by its time, as in DD-MM-YYYY HH:MM.
+#define STAMP_SIZE 16
+
+/// Shape of a stamp, with a zero in place of each digit.
+#define STAMP_TEMPLATE "00-00-0000 00:00"
+
+/// Added to each byte of a stamp XORed with its template, sets the top bit
+/// of digits above 9 and of separators that don't match.
+#define STAMP_LIMITS \
+	"\x76\x76\x7f\x76\x76\x7f\x76\x76\x76\x76\x7f\x76\x76\x7f\x76\x76"
+
+/// Top bit of every byte of a word.
+#define HIGH_BITS (~0UL / 0xFF * 0x80)
+
+/// Cents in a unit of money.
+#define CENTS_PER_UNIT 100
+
+/// Amount of money, in cents.
+typedef long int money;
+
+/// Largest amount of money read, in cents.
+#define MONEY_LIMIT 1e15
+
 /// Step in minutes for counting the cost.
 #define PARK_PAY_STEP 15
 
 /// Blocks of time that will be counted at a different price.
 #define TOTAL_INITIAL_BLOCKS 4
 
+/// Entries of a compiled tariff, one per number of started quarter-hours
+/// in a day, from none to all of them.
+#define TARIFF_SLOTS (MINS_PER_DAY / PARK_PAY_STEP + 1)
+
+/// Number of quarter-hours in a day.
+#define QUARTERS_PER_DAY (MINS_PER_DAY / PARK_PAY_STEP)
+
+/// Number of quarter-hours in a week.
+#define QUARTERS_PER_WEEK (DAYS_PER_WEEK * QUARTERS_PER_DAY)
+
+/// Prefix sums of a schedule, over two weeks so no window wraps around.
+#define SCHEDULE_SUMS (2 * QUARTERS_PER_WEEK + 1)
+
+
 /// @}
 
 /// @defgroup Registry related constants.
 /// @{
 
 /// Valid Registry types.
-typedef enum registry_types_e { ENTER, EXIT, UNDEFINED } registry_types;
+typedef enum registry_types_e { ENTER, EXIT } registry_types;
+
+/// Exit time of a stay whose vehicle is still in the park.
+#define OPEN_STAY -1
+
+/// Bits of an event position that select its row inside a chunk.
+#define EVENT_CHUNK_BITS 8
+
+/// Number of events in a chunk of an event store.
+#define EVENT_CHUNK_SIZE (1 << EVENT_CHUNK_BITS)
+
+/// Mask to extract the row inside a chunk from an event position.
+#define EVENT_CHUNK_MASK (EVENT_CHUNK_SIZE - 1)
+
+/// @}
+
+/// @defgroup command_log_constants Command log related constants.
+/// @{
+
+/// Ways of running the program, chosen at startup.
+typedef enum run_modes_e {
+	TEXT_MODE,
+	COMPILE_MODE,
+	REPLAY_MODE,
+	PIPELINE_MODE
+} run_modes;
+
+/// Command line option to compile text commands into a command log.
+#define COMPILE_OPTION "--compile"
+
+/// Command line option to replay a command log.
+#define REPLAY_OPTION "--replay"
+
+/// Bytes at the start of a command log, ending with its format version.
+#define LOG_MAGIC "IAEDLOG1"
+
+/// Number of bytes of LOG_MAGIC.
+#define LOG_MAGIC_SIZE 8
+
+/// Records of a command log other than the commands themselves.
+enum log_records { DEFINE_NAME = 'N', LIST_PARKS = 'L' };
+
+/// Slots of the name table of a command log, must be a power of 2.
+#define NAME_SLOTS 64
+
+/// Empty slot of a name table.
+#define NO_NAME -1
+
+/// @}
+
+/// @defgroup pipeline_constants Pipeline related constants.
+/// @{
+
+/// Command line option to run the commands through a pipeline of threads.
+#define PIPELINE_OPTION "--pipeline"
+
+/// Diagnostic of a startup option that needs threads in a build without.
+#define NO_THREADS_MESSAGE "option not built in, it needs threads: "
+
+/// Bits of the position of a byte inside a ring.
+#define RING_BITS 20
+
+/// Number of bytes of a ring.
+#define RING_SIZE (1 << RING_BITS)
+
+/// Mask to extract the position inside a ring from a byte count.
+#define RING_MASK (RING_SIZE - 1)
+
+/// Byte starting a field among the text of the results, never in the text.
+#define FIELD_MARKER '\0'
+
+/// Values handed to the formatter of the results.
+typedef enum result_fields_e {
+	INT_FIELD,
+	DATE_FIELD,
+	TIME_FIELD,
+	STAMP_FIELD,
+	MONEY_FIELD
+} result_fields;
+
+/// Checks of a ring a side makes before it sleeps until the other wakes it.
+#define RING_SPINS 4096
+
+/// @}
+
+/// @defgroup reclaim_constants Removed park related constants.
+/// @{
+
+/// Event chunks of removed parks freed after each command.
+#define RECLAIM_CHUNKS 4
 
 /// @}
 
@@ -95,8 +317,39 @@ enum months {
 /// Total days in a year.
 #define DAYS_IN_YEAR 365
 
+/// Total minutes in an hour.
+#define MINS_PER_HOUR 60
+
 /// Total minutes in a day.
-#define MINS_PER_DAY 24 * 60
+#define MINS_PER_DAY (24 * 60)
+
+/// Total days in a week.
+#define DAYS_PER_WEEK 7
+
+/// Shifts day numbers, with their leap days, so weeks start on Monday.
+#define WEEKDAY_OFFSET 6
+
+/// Years between two leap years.
+#define LEAP_YEAR_CYCLE 4
+
+/// Years in a century, which are only leap years every LEAP_CENTURY_CYCLE.
+#define CENTURY_YEARS 100
+
+/// Years between two centuries that are leap years.
+#define LEAP_CENTURY_CYCLE 400
+
+/// Digit of Monday in the weekdays of a tariff band, followed by the others.
+#define FIRST_WEEKDAY '1'
+
+/// Time of the day that failed to parse.
+#define INVALID_CLOCK -1
+
+/// Days from the 1st of January to the 1st of March.
+#define MARCH_OFFSET (JAN + FEB)
+
+/// Days in each cycle of five months starting in March, which alternate
+/// between 31 and 30 days.
+#define MONTH_CYCLE_DAYS 153
 
 /// @}
 
@@ -111,6 +364,23 @@ typedef enum error_codes_e {
 	UNEXPECTED_INPUT = 3
 } error_codes;
 
+/// Errors reported by the commands, in the order of their messages.
+typedef enum command_errors_e {
+	NO_ERROR,
+	PARK_EXISTS,
+	BAD_CAPACITY,
+	BAD_COST,
+	TOO_MANY_PARKS,
+	NO_SUCH_PARK,
+	PARK_FULL,
+	BAD_PLATE,
+	BAD_ENTRY,
+	BAD_EXIT,
+	NO_ENTRIES,
+	BAD_DATE,
+	BAD_BAND
+} command_errors;
+
 /// @}
 
 /// @defgroup boolean constants.
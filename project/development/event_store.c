@@ -0,0 +1,90 @@
+/**
+ * @file event_store.c
+ * @author Diogo Santos (ist1110262)
+ * @brief Append-only columnar store of park events.
+ * @version 1
+ * @date 27-03-2024
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "headers.h"
+
+/**
+ * @brief Appends an event to the store of a park.
+ *
+ * @param events Event store of the park.
+ * @param entry Stay the event belongs to.
+ * @param type ENTER or EXIT.
+ * @param cost Cost paid, 0 for entries.
+ */
+void append_event(
+	event_store *events, stay *entry, registry_types type, money cost
+) {
+	int chunk = events->event_num >> EVENT_CHUNK_BITS;
+	int row = events->event_num & EVENT_CHUNK_MASK;
+	event_chunk *current;
+
+	// Start a new chunk when the last one is full.
+	if (row == 0) {
+		if (chunk == events->chunk_size) {
+			events->chunks = grow_array(
+				events->chunks, &(events->chunk_size), sizeof(event_chunk *)
+			);
+		}
+		events->chunks[chunk] = malloc(sizeof(event_chunk));
+	}
+
+	current = events->chunks[chunk];
+	current->minutes[row] = (type == ENTER) ? entry->entry : entry->exit;
+	current->costs[row] = cost;
+	current->plates[row] = entry->vehicle_ptr->plate_id;
+	current->types[row] = type;
+	events->event_num++;
+}
+
+/**
+ * @brief Gets the chunk holding an event.
+ *
+ * @param events Event store of the park.
+ * @param event Position of the event, its row is event & EVENT_CHUNK_MASK.
+ * @return Pointer to the chunk.
+ */
+event_chunk *event_chunk_of(event_store *events, int event) {
+	return events->chunks[event >> EVENT_CHUNK_BITS];
+}
+
+/**
+ * @brief Frees the last chunk of the store.
+ *
+ * @param events Event store being freed.
+ * @return TRUE if a chunk was freed, FALSE if the store had none left.
+ */
+bool release_last_chunk(event_store *events) {
+	int chunk;
+
+	if (events->event_num == 0) return FALSE;
+
+	chunk = (events->event_num - 1) >> EVENT_CHUNK_BITS;
+	free(events->chunks[chunk]);
+	events->event_num = chunk << EVENT_CHUNK_BITS;
+	return TRUE;
+}
+
+/**
+ * @brief Frees every chunk of the store.
+ *
+ * @param events Event store to free.
+ */
+void free_events(event_store *events) {
+	int i;
+
+	for (i = 0; i * EVENT_CHUNK_SIZE < events->event_num; i++) {
+		free(events->chunks[i]);
+	}
+	free(events->chunks);
+	events->chunks = NULL;
+	events->event_num = 0;
+	events->chunk_size = 0;
+}
@@ -0,0 +1,36 @@
+/**
+ * @file event_store.h
+ * @author Diogo Santos (ist1110262)
+ * @brief Declarations of the columnar store of park events.
+ * @version 1
+ * @date 27-03-2024
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef EVENT_STORE
+#define EVENT_STORE
+
+#include "headers.h"
+
+/// @defgroup event_store_functions Event store related functions.
+/// @{
+
+/// Appends an event to the store of a park.
+void append_event(
+	event_store *events, stay *entry, registry_types type, money cost
+);
+
+/// Gets the chunk holding an event.
+event_chunk *event_chunk_of(event_store *events, int event);
+
+/// Frees the last chunk of the store.
+bool release_last_chunk(event_store *events);
+
+/// Frees every chunk of the store.
+void free_events(event_store *events);
+
+/// @}
+
+#endif
@@ -18,13 +18,27 @@
 #include <stdlib.h>
 #include <string.h>
 
+/// Threads, only used by the opt-in pipeline.
+#ifdef PIPELINED
+#include <pthread.h>
+#endif
+
 /// File Includes.
 #include "constants.h"
 #include "structs.h"
 #include "linked_list.h"
+#include "park_tree.h"
+#include "vehicle_index.h"
+#include "event_store.h"
+#include "ring.h"
+#include "output.h"
+#include "input.h"
+#include "calendar.h"
 #include "parsing.h"
-#include "sorting.h"
+#include "tariff.h"
 #include "commands.h"
+#include "command_log.h"
+#include "pipeline.h"
 #include "mem_manage.h"
 #include "menu.h"
 
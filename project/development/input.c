@@ -0,0 +1,162 @@
+/**
+ * @file input.c
+ * @author Diogo Santos (ist1110262)
+ * @brief Block reader of the standard input, splitting lines in place.
+ * @version 1
+ * @date 27-03-2024
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "headers.h"
+
+/**
+ * @brief Initializes a reader of the standard input.
+ *
+ * Regular files and binary inputs are read in blocks of INPUT_BLOCK_SIZE.
+ * Other inputs, like terminals and pipes, can't be seeked and are read a
+ * line at a time, so a command is answered as soon as it is typed.
+ *
+ * @param in Reader to initialize.
+ * @param out Writer flushed before each read.
+ * @param binary Whether the input is binary, and has no lines.
+ */
+void init_input(input_reader *in, output_writer *out, bool binary) {
+	in->out = out;
+	in->block = malloc(INPUT_BLOCK_SIZE + 1);
+	in->sentinel = NULL;
+	in->start = 0;
+	in->end = 0;
+	in->source = NULL;
+	in->whole_blocks = binary || fseek(stdin, 0, SEEK_CUR) == 0;
+	in->eof = FALSE;
+}
+
+/**
+ * @brief Frees the memory of a reader.
+ *
+ * @param in Reader to free.
+ */
+void free_input(input_reader *in) {
+	free(in->block);
+}
+
+/**
+ * @brief Reads more input after the unread part of the block.
+ *
+ * The unread part is first moved to the start of the block, so lines that
+ * straddle two reads end up contiguous. Output is flushed before reading,
+ * as the read may block.
+ *
+ * @param in Reader to refill.
+ */
+void refill_input(input_reader *in) {
+	int read;
+
+	in->end -= in->start;
+	memmove(in->block, in->block + in->start, in->end);
+	in->start = 0;
+
+	flush_output(in->out);
+	if (in->source != NULL) {
+		read = ring_read(
+			in->source, in->block + in->end, INPUT_BLOCK_SIZE - in->end
+		);
+	} else if (in->whole_blocks) {
+		read = fread(in->block + in->end, 1, INPUT_BLOCK_SIZE - in->end, stdin);
+	} else if (fgets(in->block + in->end, MAX_LINE_BUFF + 1, stdin) != NULL) {
+		read = strlen(in->block + in->end);
+	} else {
+		read = 0;
+	}
+
+	in->end += read;
+	if (read == 0) in->eof = TRUE;
+}
+
+/**
+ * @brief Gets the next line of the input, split in place.
+ *
+ * Lines are split like fgets with a MAX_LINE_BUFF + 1 buffer would: they
+ * keep their newline, and longer lines are handed out in MAX_LINE_BUFF
+ * pieces. The character after the line is swapped for a null byte until the
+ * next call.
+ *
+ * @param in Reader to take the line from.
+ * @param size Where the size of the line is stored.
+ * @return Pointer to the line, or NULL at the end of the input.
+ */
+char *next_line(input_reader *in, int *size) {
+	char *line, *newline;
+	int available, limit;
+
+	if (in->sentinel != NULL) *(in->sentinel) = in->saved;
+
+	while (TRUE) {
+		line = in->block + in->start;
+		available = in->end - in->start;
+		limit = (available < MAX_LINE_BUFF) ? available : MAX_LINE_BUFF;
+		newline = memchr(line, '\n', limit);
+
+		if (newline != NULL) {
+			*size = newline - line + 1;
+			break;
+		} else if (limit == MAX_LINE_BUFF || (in->eof && limit > 0)) {
+			*size = limit;
+			break;
+		} else if (in->eof) {
+			in->sentinel = NULL;
+			return NULL;
+		}
+		refill_input(in);
+	}
+
+	in->start += *size;
+	in->sentinel = line + *size;
+	in->saved = *(in->sentinel);
+	*(in->sentinel) = '\0';
+	return line;
+}
+
+/**
+ * @brief Gets the next bytes of a binary input.
+ *
+ * @param in Reader to take the bytes from, which reads whole blocks.
+ * @param size Number of bytes, at most INPUT_BLOCK_SIZE.
+ * @return Pointer to the bytes, or NULL if the input ends before them.
+ */
+char *next_bytes(input_reader *in, int size) {
+	char *bytes;
+
+	while (in->end - in->start < size) {
+		if (in->eof) return NULL;
+		refill_input(in);
+	}
+
+	bytes = in->block + in->start;
+	in->start += size;
+	return bytes;
+}
+
+/**
+ * @brief Gets the text of a binary input up to the next FIELD_MARKER.
+ *
+ * @param in Reader to take the text from, which reads whole blocks.
+ * @param size Where the size of the text is stored, 0 when a field is next.
+ * @return Pointer to the text, or NULL at the end of the input.
+ */
+char *next_text(input_reader *in, int *size) {
+	char *text, *marker;
+
+	while (in->start == in->end) {
+		if (in->eof) return NULL;
+		refill_input(in);
+	}
+
+	text = in->block + in->start;
+	marker = memchr(text, FIELD_MARKER, in->end - in->start);
+	*size = (marker == NULL) ? in->end - in->start : marker - text;
+	in->start += *size;
+	return text;
+}
@@ -0,0 +1,40 @@
+/**
+ * @file input.h
+ * @author Diogo Santos (ist1110262)
+ * @brief Declarations of the block input reader.
+ * @version 1
+ * @date 27-03-2024
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef INPUT
+#define INPUT
+
+#include "headers.h"
+
+/// @defgroup input_functions Input related functions.
+/// @{
+
+/// Initializes a reader of the standard input.
+void init_input(input_reader *in, output_writer *out, bool binary);
+
+/// Frees the memory of a reader.
+void free_input(input_reader *in);
+
+/// Reads more input into the block of a reader.
+void refill_input(input_reader *in);
+
+/// Gets the next line of the input, split in place.
+char *next_line(input_reader *in, int *size);
+
+/// Gets the next bytes of a binary input.
+char *next_bytes(input_reader *in, int size);
+
+/// Gets the text of a binary input up to the next FIELD_MARKER.
+char *next_text(input_reader *in, int *size);
+
+/// @}
+
+#endif
@@ -28,46 +28,65 @@ unsigned long hash(char *str) {
 }
 
 /**
- * @brief Computes hash value for a vehicle's license plate.
+ * @brief Packs the first bytes of a park name into an integer key.
  *
- * @param license_plate Vehicle's license plate.
- * @param hash_size Size of the hash table.
- * @return Hash value.
+ * The first byte goes to the most significant end and short names are
+ * padded with zeros, so keys compare like the names they come from.
+ *
+ * @param name Name of the park.
+ * @return Name key of the park.
  */
-unsigned long vehicle_hash(char *license_plate, int hash_size) {
-	return hash(license_plate) % hash_size;
+unsigned long name_key(char *name) {
+	unsigned long key = 0;
+	int i;
+
+	for (i = 0; i < NAME_KEY_BYTES; i++) {
+		key <<= BYTE_BITS;
+		if (*name != '\0') key |= (unsigned char)*name++;
+	}
+
+	return key;
 }
 
 /**
- * @brief Resizes the vehicle index hash table.
+ * @brief Compares two parks by name.
  *
- * @param vehicles Vehicle index.
+ * Names are only read past their keys when the keys are equal and both
+ * names are longer than a key.
+ *
+ * @param first First park.
+ * @param second Second park.
+ * @return Negative, zero or positive, as strcmp on the names.
+ */
+int compare_parks(park *first, park *second) {
+	if (first->name_key != second->name_key) {
+		return (first->name_key < second->name_key) ? -1 : 1;
+	}
+	if ((first->name_key & BYTE_MASK) == 0) return 0;
+
+	return strcmp(first->name + NAME_KEY_BYTES, second->name + NAME_KEY_BYTES);
+}
+
+/**
+ * @brief Resizes the park index hash table.
+ *
+ * @param parks Park index.
  * @param new_size New size for the hash table.
  */
-void resize_vehicle_index(vehicle_index *vehicles, int new_size) {
-	vehicle **new_buckets = calloc(new_size, sizeof(vehicle *)),
-			*current_vehicle, *next_vehicle;
+void resize_park_index(park_index *parks, int new_size) {
+	park **new_buckets = calloc(new_size, sizeof(park *)), *current;
 	unsigned long new_hash;
-	int i;
 
-	// Iterate over the old hash table and rehash all vehicles.
-	for (i = 0; i < vehicles->size; i++) {
-		current_vehicle = vehicles->buckets[i];
-		while (current_vehicle != NULL) {
-			next_vehicle = current_vehicle->next;
-			new_hash = vehicle_hash(current_vehicle->license_plate, new_size);
-
-			// Add the vehicle to the front of the list in the new bucket
-			current_vehicle->next = new_buckets[new_hash];
-			new_buckets[new_hash] = current_vehicle;
-			current_vehicle = next_vehicle;
-		}
+	// Rehash every park, the creation order list is left untouched.
+	for (current = parks->first; current != NULL; current = current->next) {
+		new_hash = current->hashed_name % new_size;
+		current->bucket_next = new_buckets[new_hash];
+		new_buckets[new_hash] = current;
 	}
 
-	// Free the old hash table and update the vehicle index.
-	free(vehicles->buckets);
-	vehicles->buckets = new_buckets;
-	vehicles->size = new_size;
+	free(parks->buckets);
+	parks->buckets = new_buckets;
+	parks->size = new_size;
 }
 
 /**
@@ -77,20 +96,35 @@ void resize_vehicle_index(vehicle_index *vehicles, int new_size) {
  * @param parks Park index.
  */
 void add_park(p_args *args, park_index *parks) {
-	park *new_park = malloc(sizeof(park));
-
-	// Initialize the new park values.
-	new_park->name = args->name;
-	new_park->hashed_name = hash(args->name);
+	park *new_park = slab_alloc(&(parks->pool));
+	unsigned long bucket;
+
+	// Initialize the new park values, the name outlives the command line.
+	new_park->name = malloc(args->name.size + 1);
+	memcpy(new_park->name, args->name.str, args->name.size + 1);
+	new_park->hashed_name = args->name.hash;
+	new_park->name_key = name_key(new_park->name);
 	new_park->capacity = args->capacity;
 	new_park->free_spaces = args->capacity;
-	new_park->first_hour_value = args->first_value;
-	new_park->value = args->value;
 	new_park->day_value = args->day_value;
-	new_park->registries = NULL;
-	new_park->last_reg = NULL;
+	compile_tariff(new_park, args->first_value, args->value);
+	new_park->events.chunks = NULL;
+	new_park->events.event_num = 0;
+	new_park->events.chunk_size = 0;
+	new_park->ledger = NULL;
+	new_park->ledger_num = 0;
+	new_park->ledger_size = 0;
 	new_park->next = NULL;
 
+	// Add new park to the hash table.
+	if ((float)parks->park_num / parks->size > MAX_LOAD_FACTOR) {
+		resize_park_index(parks, parks->size * GROWTH_FACTOR);
+	}
+	bucket = new_park->hashed_name % parks->size;
+	new_park->bucket_next = parks->buckets[bucket];
+	parks->buckets[bucket] = new_park;
+	parks->root = tree_insert(parks->root, new_park);
+
 	// Add new park to the end of the linked list
 	if (parks->park_num == 0) {
 		parks->first = new_park;
@@ -108,6 +142,9 @@ void add_park(p_args *args, park_index *parks) {
 /**
  * @brief Removes a park from the park index.
  *
+ * Runs in constant time: the stays of the park are left in place and only
+ * become stale, and its event store is handed to reclaim_parks.
+ *
  * @param parking Park to remove.
  * @param parks Park index.
  */
@@ -115,9 +152,8 @@ void remove_park(park *parking, park_index *parks) {
 	// If the park is NULL, there's nothing to remove
 	if (parking == NULL) return;
 
-	if (parking->registries != NULL) {
-		clean_park_registries(parking->registries);
-	}
+	unlink_park_bucket(parking, parks);
+	parks->root = tree_remove(parks->root, parking);
 
 	// If the park isnt the first update next
 	if (parking->previous != NULL) {
@@ -139,100 +175,66 @@ void remove_park(park *parking, park_index *parks) {
 		parks->last = parking->previous;
 	}
 
-	// Free the memory allocated for the park's name and the park itself
+	// Stays of the park become stale, its events are freed later.
+	parking->generation++;
+	free(parking->ledger);
+	free(parking->schedule);
 	free(parking->name);
-	free(parking);
+	parking->next = parks->graveyard;
+	parks->graveyard = parking;
 	parks->park_num--;
 }
 
 /**
- * @brief Lists all parks in the park index.
+ * @brief Removes a park from its hash table bucket.
  *
+ * @param parking Park to unlink.
  * @param parks Park index.
  */
-void show_parks(park_index *parks) {
-	int i;
-	park *current = parks->first;
-	for (i = 0; i < parks->park_num; i++) {
-		printf(
-			"%s %i %i\n", current->name, current->capacity,
-			current->free_spaces
-		);
-		current = current->next;
+void unlink_park_bucket(park *parking, park_index *parks) {
+	park **current = &(parks->buckets[parking->hashed_name % parks->size]);
+
+	while (*current != parking) {
+		current = &((*current)->bucket_next);
 	}
+	*current = parking->bucket_next;
 }
 
 /**
- * @brief Finds a park in the park index.
+ * @brief Lists all parks in the park index.
  *
- * @param name Name of the park.
- * @param name_hash Hashed name of the park.
  * @param parks Park index.
- * @return Pointer to the park if found, NULL otherwise.
+ * @param out Output writer.
  */
-park *find_park(char *name, unsigned long name_hash, park_index *parks) {
+void show_parks(park_index *parks, output_writer *out) {
 	int i;
 	park *current = parks->first;
 	for (i = 0; i < parks->park_num; i++) {
-		if (name_hash == current->hashed_name) {
-			if (strcmp(name, current->name) == 0) return current;
-		}
+		write_str(out, current->name);
+		write_char(out, ' ');
+		write_int(out, current->capacity);
+		write_char(out, ' ');
+		write_int(out, current->free_spaces);
+		write_char(out, '\n');
 		current = current->next;
 	}
-
-	return NULL;
 }
 
 /**
- * @brief Adds a new vehicle to the vehicle index.
+ * @brief Finds a park in the park index.
  *
- * @param license_plate License plate of the vehicle.
- * @param vehicles Vehicle index.
- * @return Pointer to the new vehicle.
+ * @param name Name of the park, with its hash.
+ * @param parks Park index.
+ * @return Pointer to the park if found, NULL otherwise.
  */
-vehicle *add_vehicle(char *license_plate, vehicle_index *vehicles) {
-	vehicle *new_vehicle = malloc(sizeof(vehicle));
-	unsigned long hash;
-	float load_factor;
-
-	// Calculate the load factor
-	load_factor = (float)vehicles->vehicle_num / vehicles->size;
-	if (load_factor > 0.75) {
-		resize_vehicle_index(vehicles, vehicles->size * 2);
-	}
-
-	hash = vehicle_hash(license_plate, vehicles->size);
-
-	memcpy(new_vehicle->license_plate, license_plate, LICENSE_PLATE_SIZE + 1);
-	new_vehicle->hashed_plate = hash;
-	new_vehicle->registries = NULL;
-	new_vehicle->last_reg = NULL;
-
-	// Add the vehicle to the appropriate bucket
-	new_vehicle->next = vehicles->buckets[hash];
-	vehicles->buckets[hash] = new_vehicle;
-
-	vehicles->vehicle_num++;
-	return new_vehicle;
-}
+park *find_park(name_view *name, park_index *parks) {
+	park *current = parks->buckets[name->hash % parks->size];
 
-/**
- * @brief Finds a vehicle in the vehicle index.
- *
- * @param license_plate License plate of the vehicle.
- * @param vehicles Vehicle index.
- * @return Pointer to the vehicle if found, NULL otherwise.
- */
-vehicle *find_vehicle(char *license_plate, vehicle_index *vehicles) {
-	unsigned long license_plate_hash =
-		vehicle_hash(license_plate, vehicles->size);
-	vehicle *current_vehicle = vehicles->buckets[license_plate_hash];
-
-	while (current_vehicle != NULL) {
-		if (strcmp(current_vehicle->license_plate, license_plate) == 0) {
-			return current_vehicle;
+	while (current != NULL) {
+		if (name->hash == current->hashed_name) {
+			if (strcmp(name->str, current->name) == 0) return current;
 		}
-		current_vehicle = current_vehicle->next;
+		current = current->bucket_next;
 	}
 
 	return NULL;
@@ -241,284 +243,295 @@ vehicle *find_vehicle(char *license_plate, vehicle_index *vehicles) {
 /**
  * @brief Registers the entrance of a vehicle to a park.
  *
- * @param args Arguments for the 'e' command.
- * @param vehicles Vehicle index.
+ * Opens a stay, listed by the vehicle history of the park and by the entry
+ * event of the park.
+ *
+ * @param args Arguments for the 'e' command, with the vehicle already added.
+ * @param pools Registry allocators.
  */
-void register_entrance(e_args *args, vehicle_index *vehicles) {
-	registry_union *entry = malloc(sizeof(registry_union));
-
-	// create vehicle if it doesnt exist
-	if (args->vehicle == NULL) {
-		args->vehicle = add_vehicle(args->license_plate, vehicles);
-	}
-
-	entry->enter.park_ptr = args->park;
-	entry->enter.vehicle_ptr = args->vehicle;
-	entry->enter.timestamp = args->timestamp;
-
-	add_entry(
-		&(args->vehicle->registries), &(args->vehicle->last_reg), entry, ENTER
-	);
-	add_entry(
-		&(args->park->registries), &(args->park->last_reg), entry, ENTER
-	);
+void register_entrance(e_args *args, registry_pools *pools) {
+	stay *entry = slab_alloc(&(pools->payloads));
+	park_history *history;
+
+	entry->park_ptr = args->park;
+	entry->park_generation = args->park->generation;
+	entry->vehicle_ptr = args->vehicle;
+	entry->entry = args->timestamp.total_mins;
+	entry->exit = OPEN_STAY;
+	entry->cost = 0;
+
+	history = find_history(args->vehicle, args->park, pools);
+	add_entry(&(history->registries), &(history->last_reg), entry, pools);
+	args->vehicle->last_stay = entry;
+	append_event(&(args->park->events), entry, ENTER, 0);
 	(args->park->free_spaces)--;
 }
 
 /**
  * @brief Registers the exit of a vehicle from a park.
  *
+ * Completes the open stay of the vehicle in place.
+ *
  * @param args Arguments for the 's' command.
  */
 void register_exit(s_args *args) {
-	registry_union *entry = malloc(sizeof(registry_union));
-
-	entry->exit.park_ptr = args->park;
-	entry->exit.vehicle_ptr = args->vehicle;
-	entry->exit.timestamp = args->end;
-	entry->exit.cost = args->cost;
-
-	add_entry(
-		&(args->vehicle->registries), &(args->vehicle->last_reg), entry, EXIT
-	);
-	add_entry(&(args->park->registries), &(args->park->last_reg), entry, EXIT);
-	(args->park->free_spaces)++;
+	stay *entry = args->vehicle->last_stay;
+	park *parking = args->park;
+
+	entry->exit = args->end.total_mins;
+	entry->cost = args->cost;
+
+	append_event(&(parking->events), entry, EXIT, args->cost);
+	record_revenue(parking, args->end.total_mins, args->cost);
+	(parking->free_spaces)++;
+}
+
+/**
+ * @brief Adds the cost of an exit to the daily ledger of a park.
+ *
+ * Exits are chronological, so only the last day of the ledger can match.
+ * The exit must already be the last event of the park.
+ *
+ * @param parking Park the vehicle left.
+ * @param exit_date Minutes of the exit.
+ * @param cost Cost paid on exit.
+ */
+void record_revenue(park *parking, long int exit_date, money cost) {
+	ledger_day *last;
+
+	if (parking->ledger_num > 0) {
+		last = &(parking->ledger[parking->ledger_num - 1]);
+		if (last->day == day_number(exit_date)) {
+			last->revenue += cost;
+			last->exits++;
+			return;
+		}
+	}
+
+	if (parking->ledger_num == parking->ledger_size) {
+		parking->ledger = grow_array(
+			parking->ledger, &(parking->ledger_size), sizeof(ledger_day)
+		);
+	}
+
+	last = &(parking->ledger[parking->ledger_num++]);
+	last->day = day_number(exit_date);
+	last->revenue = cost;
+	last->exits = 1;
+	last->first_exit = parking->events.event_num - 1;
 }
 
 /**
- * @brief Adds a new entry to a registry.
+ * @brief Adds a stay to a registry list.
  *
  * @param reg Pointer to the registry.
  * @param last_reg Pointer to the last registry.
- * @param entry Entry to add.
- * @param type Type of the registry (ENTER or EXIT).
+ * @param entry Stay to add.
+ * @param pools Registry allocators.
  */
 void add_entry(
-	registry **reg, registry **last_reg, registry_union *entry,
-	registry_types type
+	registry **reg, registry **last_reg, stay *entry, registry_pools *pools
 ) {
-	registry *temp_reg, *new_reg;
+	registry *new_reg = slab_alloc(&(pools->nodes));
 
-	new_reg = malloc(sizeof(registry));
 	new_reg->next = NULL;
-	new_reg->type = type;
-	new_reg->registration = entry;
+	new_reg->stay_ptr = entry;
 
 	if (*reg == NULL) {
 		*reg = new_reg;
-		*last_reg = new_reg;
 	} else {
-		temp_reg = *last_reg;
-		temp_reg->next = new_reg;
-		*last_reg = new_reg;
+		(*last_reg)->next = new_reg;
 	}
+	*last_reg = new_reg;
 }
 
 /**
- * @brief Prints all registries in the given array.
+ * @brief Finds the history of a vehicle in a park, creating it if needed.
+ *
+ * Histories are kept in park name order, so names are only compared when a
+ * vehicle enters a park for the first time. Histories of removed parks have
+ * their stays detached and are skipped.
  *
- * @param regs Array of registries.
- * @param last_reg Last registry in the array.
- * @param size Size of the array.
+ * @param owner Vehicle entering the park.
+ * @param parking Park being entered.
+ * @param pools Registry allocators.
+ * @return Pointer to the history of the vehicle in the park.
  */
-void show_all_regs(registry **regs, registry *last_reg, int *size) {
-	date *timestamp;
-	int i;
-
-	if (last_reg->type == EXIT) {
-		for (i = 0; i < *size; i++) {
-			print_registry(regs[i]);
-		}
-		// Extra checking is needed for the last print with \n.
-	} else {
-		for (i = 0; i < *size; i++) {
-			if (regs[i] == last_reg) {
-				timestamp = &(regs[i]->registration->enter.timestamp);
-				printf(
-					"%s %02d-%02d-%04d %02d:%02d\n",
-					last_reg->registration->enter.park_ptr->name,
-					timestamp->days, timestamp->months, timestamp->years,
-					timestamp->hours, timestamp->minutes
-				);
-			} else
-				print_registry(regs[i]);
-		}
+park_history *find_history(
+	vehicle *owner, park *parking, registry_pools *pools
+) {
+	park_history **current = &(owner->histories), *new_history;
+	park *current_park;
+
+	while (*current != NULL) {
+		current_park = history_park(*current);
+		if (current_park == parking) return *current;
+		if (current_park != NULL && compare_parks(parking, current_park) < 0)
+			break;
+		current = &((*current)->next);
 	}
+
+	new_history = slab_alloc(&(pools->histories));
+	new_history->registries = NULL;
+	new_history->last_reg = NULL;
+	new_history->next = *current;
+	*current = new_history;
+	return new_history;
 }
 
 /**
- * @brief Prints a single registry.
+ * @brief Gets the park of a vehicle history.
  *
- * @param reg Registry to print.
+ * @param history History of a vehicle.
+ * @return Pointer to the park, or NULL if the park was removed.
  */
-void print_registry(registry *reg) {
-	date *timestamp;
-
-	if (reg->type == ENTER) {
-		timestamp = &(reg->registration->enter.timestamp);
-		printf(
-			"%s %02d-%02d-%04d %02d:%02d",
-			reg->registration->enter.park_ptr->name, timestamp->days,
-			timestamp->months, timestamp->years, timestamp->hours,
-			timestamp->minutes
-		);
-	} else {
-		timestamp = &(reg->registration->exit.timestamp);
-		printf(
-			" %02d-%02d-%04d %02d:%02d\n", timestamp->days, timestamp->months,
-			timestamp->years, timestamp->hours, timestamp->minutes
-		);
+park *history_park(park_history *history) {
+	return stay_park(history->registries->stay_ptr);
+}
+
+/**
+ * @brief Gets the park of a stay, unless the park was removed.
+ *
+ * Parks come from a slab and are never handed back to the system while
+ * running, so the generation of a removed park can still be compared.
+ *
+ * @param entry Stay to check.
+ * @return Pointer to the park, or NULL if the park was removed.
+ */
+park *stay_park(stay *entry) {
+	if (entry->park_ptr->generation != entry->park_generation) return NULL;
+	return entry->park_ptr;
+}
+
+/**
+ * @brief Checks if a vehicle has stays in a park that was not removed.
+ *
+ * @param owner Vehicle to check.
+ * @return TRUE if any history of the vehicle is live, FALSE otherwise.
+ */
+bool has_live_history(vehicle *owner) {
+	park_history *current;
+
+	for (current = owner->histories; current != NULL; current = current->next) {
+		if (history_park(current) != NULL) return TRUE;
 	}
+	return FALSE;
 }
 
 /**
- * @brief Counts and returns non-null registries from a linked list.
+ * @brief Prints all stays of a vehicle, by park name and then by entry.
  *
- * @param first_reg First registry in the linked list.
- * @param destination Pointer to the destination array.
- * @return Count of non-null registries.
+ * @param owner Vehicle to list.
+ * @param out Output writer.
  */
-int get_non_null_registries(registry *first_reg, registry ***destination) {
-	int count = 0;
-	registry *current = first_reg;
-	while (current != NULL) {
-		if ((current->type == ENTER &&
-				current->registration->enter.park_ptr != NULL) ||
-			(current->type == EXIT &&
-				current->registration->exit.park_ptr != NULL)) {
-
-			// Resize array in chunks
-			if (count % CHUNK_SIZE == 0) {
-				*destination = realloc(
-					*destination, (count + CHUNK_SIZE) * sizeof(registry *)
-				);
-			}
-			(*destination)[count] = current;
-			count++;
+void show_all_regs(vehicle *owner, output_writer *out) {
+	park_history *current;
+	registry *reg;
+
+	for (current = owner->histories; current != NULL; current = current->next) {
+		if (history_park(current) == NULL) continue;
+
+		for (reg = current->registries; reg != NULL; reg = reg->next) {
+			print_registry(reg, out);
 		}
-		current = current->next;
 	}
-	return count;
 }
 
 /**
- * @brief Finds a registry of a specific type in a linked list of registries.
+ * @brief Prints a single stay, without its exit if it is still open.
  *
- * @param reg First registry in the linked list.
- * @param type Type of the registry to find.
- * @return Pointer to the found registry, or NULL if not found.
+ * @param reg Registry to print.
+ * @param out Output writer.
  */
-registry *find_reg(registry *first_reg, registry_types type) {
-	registry *current_reg = first_reg;
-	while (current_reg != NULL) {
-		if (current_reg->type == type) {
-			return current_reg;
-		}
-		current_reg = current_reg->next;
+void print_registry(registry *reg, output_writer *out) {
+	stay *entry = reg->stay_ptr;
+
+	write_str(out, entry->park_ptr->name);
+	write_char(out, ' ');
+	write_stamp(out, entry->entry);
+
+	if (entry->exit != OPEN_STAY) {
+		write_char(out, ' ');
+		write_stamp(out, entry->exit);
 	}
-	return NULL;
+	write_char(out, '\n');
 }
 
 /**
  * @brief Prints the total cost of all exits from a park for each day.
  *
  * @param parking Pointer to the park.
+ * @param out Output writer.
  */
-void show_billing(park *parking) {
-	registry *current_reg;
-	date *old_date, *current_date;
-	float total_cost = 0;
-
-	// Find the first exit registry
-	current_reg = find_reg(parking->registries, EXIT);
-	if (current_reg == NULL) return;
-	old_date = &(current_reg->registration->exit.timestamp);
-
-	while (current_reg != NULL) {
-		if (current_reg->type == EXIT) {
-			current_date = &(current_reg->registration->exit.timestamp);
-
-			if (is_same_day(old_date, current_date)) {
-				total_cost += current_reg->registration->exit.cost;
-			} else {
-				printf(
-					"%02d-%02d-%04d %.2f\n", old_date->days, old_date->months,
-					old_date->years, total_cost
-				);
-				total_cost = current_reg->registration->exit.cost;
-				old_date = current_date;
-			}
-		}
+void show_billing(park *parking, output_writer *out) {
+	ledger_day *current;
+	int i;
 
-		current_reg = current_reg->next;
+	for (i = 0; i < parking->ledger_num; i++) {
+		current = &(parking->ledger[i]);
+		write_date(out, current->day * MINS_PER_DAY);
+		write_char(out, ' ');
+		write_money(out, current->revenue);
+		write_char(out, '\n');
 	}
-
-	printf(
-		"%02d-%02d-%04d %.2f\n", old_date->days, old_date->months,
-		old_date->years, total_cost
-	);
 }
 
 /**
- * @brief Prints the cost of all exits from a park for a specific day.
+ * @brief Finds the ledger entry of a day with a binary search.
  *
  * @param parking Pointer to the park.
- * @param day Date of the day to show billing for.
+ * @param day Date of the day to find.
+ * @return Pointer to the ledger entry, or NULL if there were no exits.
  */
-void show_billing_day(park *parking, date *day) {
-	registry *current_reg = parking->registries;
-	registry_exit *current_exit;
-	date *temp_date;
-
-	// Find the first exit registry of the day
-	while (current_reg != NULL) {
-		if (current_reg->type == EXIT) {
-			temp_date = &(current_reg->registration->enter.timestamp);
-			if (is_same_day(day, temp_date)) break;
+ledger_day *find_ledger_day(park *parking, date *day) {
+	long int wanted = day_number(day->total_mins), current;
+	int low = 0, high = parking->ledger_num - 1, mid;
+
+	while (low <= high) {
+		mid = low + (high - low) / 2;
+		current = parking->ledger[mid].day;
+
+		if (current == wanted) return &(parking->ledger[mid]);
+		if (current < wanted) {
+			low = mid + 1;
+		} else {
+			high = mid - 1;
 		}
-		current_reg = current_reg->next;
 	}
 
-	while (current_reg != NULL) {
-		if (current_reg->type == EXIT) {
-			temp_date = &(current_reg->registration->enter.timestamp);
-
-			if (is_same_day(day, temp_date)) {
-				current_exit = &(current_reg->registration->exit);
-				printf(
-					"%s %02d:%02d %.2f\n",
-					current_exit->vehicle_ptr->license_plate,
-					current_exit->timestamp.hours,
-					current_exit->timestamp.minutes, current_exit->cost
-				);
-			} else {
-				break;
-			}
-		}
-
-		current_reg = current_reg->next;
-	}
+	return NULL;
 }
 
 /**
- * @brief Get the names of all parks in a park index.
+ * @brief Prints the cost of all exits from a park for a specific day.
  *
- * @param parks Pointer to the park index.
- * @param park_names Pointer to the destination array for the park names.
- * @return Count of parks.
+ * @param parking Pointer to the park.
+ * @param day Date of the day to show billing for.
+ * @param out Output writer.
  */
-int get_park_names(park_index *parks, char ***park_names) {
-	park *current = parks->first;
-	int count = 0;
-
-	while (current != NULL) {
-		if (count % 10 == CHUNK_SIZE) {
-			*park_names =
-				realloc(*park_names, (count + CHUNK_SIZE) * sizeof(char *));
-		}
-		(*park_names)[count] = current->name;
-		count++;
-		current = current->next;
+void show_billing_day(park *parking, date *day, output_writer *out) {
+	ledger_day *billing_day = find_ledger_day(parking, day);
+	event_chunk *chunk;
+	char license_plate[LICENSE_PLATE_SIZE + 1];
+	int event, row, printed = 0, minutes;
+
+	if (billing_day == NULL) return;
+
+	// Entries of the day are interleaved with its exits, skip them.
+	for (event = billing_day->first_exit; printed < billing_day->exits;
+		event++) {
+		chunk = event_chunk_of(&(parking->events), event);
+		row = event & EVENT_CHUNK_MASK;
+		if (chunk->types[row] != EXIT) continue;
+
+		decode_plate(chunk->plates[row], license_plate);
+		minutes = minute_of_day(chunk->minutes[row]);
+		write_bytes(out, license_plate, LICENSE_PLATE_SIZE);
+		write_char(out, ' ');
+		write_time(out, minutes / MINS_PER_HOUR, minutes % MINS_PER_HOUR);
+		write_char(out, ' ');
+		write_money(out, chunk->costs[row]);
+		write_char(out, '\n');
+		printed++;
 	}
-	return count;
-}
\ No newline at end of file
+}
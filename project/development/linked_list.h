@@ -23,50 +23,69 @@ void add_park(p_args *args, park_index *parks);
 /// Remove park from parks list.
 void remove_park(park *parking, park_index *parks);
 
+/// Remove park from its hash table bucket.
+void unlink_park_bucket(park *parking, park_index *parks);
+
 /// List all parks.
-void show_parks(park_index *parks);
+void show_parks(park_index *parks, output_writer *out);
+
+/// Find the ledger entry of a park for a specific day.
+ledger_day *find_ledger_day(park *parking, date *day);
 
 /// List the billing of a park for a specific day.
-void show_billing_day(park *parking, date *day);
+void show_billing_day(park *parking, date *day, output_writer *out);
 
 /// List the billing of a park generally.
-void show_billing(park *parking);
+void show_billing(park *parking, output_writer *out);
 
-/// Get all park names and store them in a vector.
-int get_park_names(park_index *parks, char ***park_names);
+/// Pack the first bytes of a park name into a key ordered like the names.
+unsigned long name_key(char *name);
+
+/// Compare two parks by name, as strcmp does.
+int compare_parks(park *first, park *second);
 
 /// @}
 
 /// @defgroup vehicle_functions Vehicle related functions.
 /// @{
 
-/// Add a new vehicle to vehicles hashtable.
-vehicle *add_vehicle(char *license_plate, vehicle_index *vehicles);
-
 /// Register a new entrace of a vehicle in a park.
-void register_entrance(e_args *args, vehicle_index *vehicles);
+void register_entrance(e_args *args, registry_pools *pools);
+
+/// Find the history of a vehicle in a park, creating it if needed.
+park_history *find_history(
+	vehicle *owner, park *parking, registry_pools *pools
+);
+
+/// Get the park of a vehicle history.
+park *history_park(park_history *history);
+
+/// Get the park of a stay, unless it was removed.
+park *stay_park(stay *entry);
+
+/// Check if a vehicle has stays in parks that were not removed.
+bool has_live_history(vehicle *owner);
 
 /// Register a new exit of a vehicle in a park.
 void register_exit(s_args *args);
 
+/// Add the cost of an exit to the daily ledger of a park.
+void record_revenue(park *parking, long int exit_date, money cost);
+
 /// @}
 
 /// @defgroup registry_functions Registry related functions.
 /// @{
 
 /// List registry.
-void print_registry(registry *reg);
-
-/// Get all registries and store them in a vector.
-int get_non_null_registries(registry *first_reg, registry ***destination);
+void print_registry(registry *reg, output_writer *out);
 
-/// List all registries.
-void show_all_regs(registry **regs, registry *last_reg, int *size);
+/// List all registries of a vehicle.
+void show_all_regs(vehicle *owner, output_writer *out);
 
-/// Add the entry to the registry list of a park or vehicle.
+/// Add the stay to the registry list of a park or vehicle.
 void add_entry(
-	registry **reg, registry **last_reg, registry_union *entry,
-	registry_types type
+	registry **reg, registry **last_reg, stay *entry, registry_pools *pools
 );
 
 /// @}
@@ -75,13 +94,7 @@ void add_entry(
 /// @{
 
 /// Find a park by name.
-park *find_park(char *name, unsigned long park_hash, park_index *parks);
-
-/// Find a vehicle by its license_plate.
-vehicle *find_vehicle(char *license_plate, vehicle_index *vehicles);
-
-/// Find a registry by type.
-registry *find_reg(registry *reg, registry_types type);
+park *find_park(name_view *name, park_index *parks);
 
 /// @}
 
@@ -91,11 +104,8 @@ registry *find_reg(registry *reg, registry_types type);
 /// Main hashing function - djb2.
 unsigned long hash(char *str);
 
-/// Computes hash for vehicles based on license plate.
-unsigned long vehicle_hash(char *license_plate, int hash_size);
-
-/// Resize vehicle hashtable.
-void resize_vehicle_index(vehicle_index *index, int new_size);
+/// Resize park hashtable.
+void resize_park_index(park_index *parks, int new_size);
 
 /// @}
 
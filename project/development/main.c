@@ -14,9 +14,16 @@
 /**
  * @brief  Main function that starts the application.
  *
+ * @param argc Number of command line arguments.
+ * @param argv Command line arguments.
  * @return SUCCESSFUL if the program executes without errors,
  * UNEXPECTED if an unexpected error occurs, and UNEXPECTED_INPUT if the
  * program receives an input that it doesn't know how to handle.
  *
  */
-int main() { return menu(); }
\ No newline at end of file
+int main(int argc, char **argv) {
+	config conf = {.max_parks = DEFAULT_MAX_PARKS, .mode = TEXT_MODE};
+
+	if (parse_config(argc, argv, &conf) != SUCCESSFUL) return UNEXPECTED_INPUT;
+	return menu(&conf);
+}
\ No newline at end of file
@@ -14,65 +14,153 @@
 /**
  * @brief Frees all allocated memory.
  *
+ * Parks and registries are not freed one by one, their slabs are released
+ * in bulk.
+ *
  * @param parks Pointer to the park index.
  * @param vehicles Pointer to the vehicle index.
+ * @param pools Pointer to the registry allocators.
  */
-void free_all(park_index *parks, vehicle_index *vehicles) {
-	int park_num = parks->park_num, i;
-	for (i = 0; i < park_num; i++) {
-		remove_park(parks->first, parks);
+void free_all(
+	park_index *parks, vehicle_index *vehicles, registry_pools *pools
+) {
+	park *current;
+
+	for (current = parks->first; current != NULL; current = current->next) {
+		free_events(&(current->events));
+		free(current->ledger);
+		free(current->schedule);
+		free(current->name);
 	}
+	for (current = parks->graveyard; current != NULL; current = current->next) {
+		free_events(&(current->events));
+	}
+	release_slabs(&(parks->pool));
+	free(parks->buckets);
 	remove_all_vehicles(vehicles);
-	free(vehicles->buckets);
+	release_slabs(&(pools->nodes));
+	release_slabs(&(pools->payloads));
+	release_slabs(&(pools->histories));
 }
 
 /**
- * @brief Cleans all registries associated with a park.
+ * @brief Frees part of the event stores of removed parks.
+ *
+ * At most RECLAIM_CHUNKS chunks are freed per call, so removing a busy park
+ * never stalls a single command. The vehicles that entered the park are
+ * compacted before each chunk is freed, and parks are returned to the pool
+ * once their store is empty.
  *
- * @param reg Pointer to the first registry in the linked list.
+ * @param parks Pointer to the park index.
+ * @param vehicles Pointer to the vehicle index.
+ * @param pools Pointer to the registry allocators.
  */
-void clean_park_registries(registry *reg) {
-	registry *temp_reg;
+void reclaim_parks(
+	park_index *parks, vehicle_index *vehicles, registry_pools *pools
+) {
+	park *dead = parks->graveyard;
+	int step = 0;
+
+	while (dead != NULL && step < RECLAIM_CHUNKS) {
+		if (dead->events.event_num > 0) {
+			compact_chunk(&(dead->events), vehicles, pools);
+			release_last_chunk(&(dead->events));
+			step++;
+			continue;
+		}
 
-	if ((*reg).type == ENTER) {
-		(*reg).registration->enter.park_ptr = NULL;
-	} else {
-		(*reg).registration->exit.park_ptr = NULL;
+		free_events(&(dead->events));
+		parks->graveyard = dead->next;
+		slab_free(&(parks->pool), dead);
+		dead = parks->graveyard;
 	}
+}
 
-	while ((*reg).next != NULL) {
-		temp_reg = (*reg).next->next;
+/**
+ * @brief Compacts the vehicles with entries in the last chunk of a store.
+ *
+ * Vehicles are found by plate, the stays of the chunk may already be freed.
+ *
+ * @param events Event store of a removed park.
+ * @param vehicles Pointer to the vehicle index.
+ * @param pools Pointer to the registry allocators.
+ */
+void compact_chunk(
+	event_store *events, vehicle_index *vehicles, registry_pools *pools
+) {
+	int first = (events->event_num - 1) & ~EVENT_CHUNK_MASK, row;
+	event_chunk *chunk = event_chunk_of(events, first);
+	vehicle *owner;
 
-		if ((*reg).next->type == ENTER) {
-			(*reg).next->registration->enter.park_ptr = NULL;
-		} else {
-			(*reg).next->registration->exit.park_ptr = NULL;
-		}
+	for (row = 0; row < events->event_num - first; row++) {
+		if (chunk->types[row] != ENTER) continue;
 
-		free((*reg).next);
-		(*reg).next = temp_reg;
+		owner = find_vehicle(chunk->plates[row], vehicles);
+		if (owner != NULL) compact_vehicle(owner, vehicles, pools);
 	}
-	free(reg);
 }
 
 /**
- * @brief Cleans all registries associated with a vehicle.
+ * @brief Frees the histories of a vehicle in removed parks.
+ *
+ * The vehicle itself is removed once it has no history left.
  *
- * @param reg Pointer to the first registry in the linked list.
+ * @param owner Vehicle to compact.
+ * @param vehicles Pointer to the vehicle index.
+ * @param pools Pointer to the registry allocators.
  */
-void clean_vehicle_registries(registry *reg) {
-	registry *next_reg = (*reg).next;
-	registry *temp_reg;
+void compact_vehicle(
+	vehicle *owner, vehicle_index *vehicles, registry_pools *pools
+) {
+	park_history **current = &(owner->histories), *dead;
 
-	free((*reg).registration);
+	while (*current != NULL) {
+		if (history_park(*current) != NULL) {
+			current = &((*current)->next);
+			continue;
+		}
 
-	while (next_reg != NULL) {
-		temp_reg = next_reg->next;
-		free(next_reg->registration);
-		free(next_reg);
-		next_reg = temp_reg;
+		dead = *current;
+		*current = dead->next;
+		free_history(owner, dead, pools);
 	}
-	free(reg);
+
+	if (owner->histories == NULL) remove_vehicle(owner, vehicles);
+}
+
+/**
+ * @brief Returns the stays of a history and the history to their pools.
+ *
+ * @param owner Vehicle the history belongs to.
+ * @param history History to free, already unlinked.
+ * @param pools Pointer to the registry allocators.
+ */
+void free_history(
+	vehicle *owner, park_history *history, registry_pools *pools
+) {
+	registry *current = history->registries, *next;
+
+	while (current != NULL) {
+		next = current->next;
+		if (current->stay_ptr == owner->last_stay) owner->last_stay = NULL;
+		slab_free(&(pools->payloads), current->stay_ptr);
+		slab_free(&(pools->nodes), current);
+		current = next;
+	}
+	slab_free(&(pools->histories), history);
+}
+
+/**
+ * @brief Grows a dynamic array, doubling its size.
+ *
+ * @param array Array to grow, may be NULL.
+ * @param size Pointer to the number of elements, updated.
+ * @param element_size Size of each element.
+ * @return Pointer to the grown array.
+ */
+void *grow_array(void *array, int *size, size_t element_size) {
+	*size = (*size == 0) ? CHUNK_SIZE : *size * GROWTH_FACTOR;
+	return realloc(array, *size * element_size);
 }
 
 /**
@@ -82,24 +170,84 @@ void clean_vehicle_registries(registry *reg) {
  * @param vehicles Pointer to the vehicle index.
  */
 void remove_all_vehicles(vehicle_index *vehicles) {
-	int i;
-	for (i = 0; i < vehicles->size; i++) {
-		vehicle *current_vehicle = vehicles->buckets[i], *next_vehicle;
-
-		while (current_vehicle != NULL) {
-			next_vehicle = current_vehicle->next;
-
-			// If the vehicle has registries, clean them
-			if (current_vehicle->registries != NULL) {
-				clean_vehicle_registries(current_vehicle->registries);
-			}
-
-			// Free the memory for the vehicle's registry and the vehicle
-			// itself
-			free(current_vehicle);
-			vehicles->vehicle_num--;
-			current_vehicle = next_vehicle;
-		}
-		vehicles->buckets[i] = NULL;
+	free(vehicles->plates);
+	free(vehicles->vehicles);
+	release_slabs(&(vehicles->pool));
+	vehicles->vehicle_num = 0;
+}
+
+/**
+ * @brief Initializes an empty slab allocator.
+ *
+ * @param allocator Allocator to initialize.
+ * @param object_size Size of the objects, rounded up to hold a pointer.
+ */
+void init_slab(slab_allocator *allocator, size_t object_size) {
+	if (object_size % sizeof(void *) != 0) {
+		object_size += sizeof(void *) - object_size % sizeof(void *);
+	}
+
+	allocator->object_size = object_size;
+	allocator->free_list = NULL;
+	allocator->slabs = NULL;
+	allocator->next_free = NULL;
+	allocator->slab_end = NULL;
+}
+
+/**
+ * @brief Allocates an object, reusing freed ones first.
+ *
+ * @param allocator Allocator to take the object from.
+ * @return Pointer to the object, zeroed if it was never used before.
+ */
+void *slab_alloc(slab_allocator *allocator) {
+	void *object = allocator->free_list;
+	slab *new_slab;
+
+	if (object != NULL) {
+		allocator->free_list = *(void **)object;
+		return object;
+	}
+
+	// Carve a new slab when the current one is exhausted.
+	if (allocator->next_free == allocator->slab_end) {
+		new_slab =
+			calloc(1, sizeof(slab) + SLAB_OBJECTS * allocator->object_size);
+		new_slab->next = allocator->slabs;
+		allocator->slabs = new_slab;
+		allocator->next_free = (char *)(new_slab + 1);
+		allocator->slab_end =
+			allocator->next_free + SLAB_OBJECTS * allocator->object_size;
 	}
-}
\ No newline at end of file
+
+	object = allocator->next_free;
+	allocator->next_free += allocator->object_size;
+	return object;
+}
+
+/**
+ * @brief Returns an object to its allocator free list.
+ *
+ * @param allocator Allocator the object was taken from.
+ * @param object Object to recycle.
+ */
+void slab_free(slab_allocator *allocator, void *object) {
+	*(void **)object = allocator->free_list;
+	allocator->free_list = object;
+}
+
+/**
+ * @brief Releases every slab of an allocator at once.
+ *
+ * @param allocator Allocator to empty.
+ */
+void release_slabs(slab_allocator *allocator) {
+	slab *current = allocator->slabs, *next;
+
+	while (current != NULL) {
+		next = current->next;
+		free(current);
+		current = next;
+	}
+	init_slab(allocator, allocator->object_size);
+}
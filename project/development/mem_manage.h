@@ -18,17 +18,53 @@
 /// @{
 
 /// Frees all allocated memory.
-void free_all(park_index *parks, vehicle_index *vehicles);
+void free_all(
+	park_index *parks, vehicle_index *vehicles, registry_pools *pools
+);
 
-/// Clean the registries from a specific park.
-void clean_park_registries(registry *reg);
+/// Free part of the event stores of removed parks.
+void reclaim_parks(
+	park_index *parks, vehicle_index *vehicles, registry_pools *pools
+);
 
-/// Clean the registries from a specific vehicle.
-void clean_vehicle_registries(registry *reg);
+/// Compact the vehicles with entries in the last chunk of a store.
+void compact_chunk(
+	event_store *events, vehicle_index *vehicles, registry_pools *pools
+);
 
-/// Remove all vehicles from hashtable.
+/// Free the histories of a vehicle in removed parks.
+void compact_vehicle(
+	vehicle *owner, vehicle_index *vehicles, registry_pools *pools
+);
+
+/// Free a history and its stays.
+void free_history(
+	vehicle *owner, park_history *history, registry_pools *pools
+);
+
+/// Grow a dynamic array.
+void *grow_array(void *array, int *size, size_t element_size);
+
+/// Remove all vehicles from the vehicle index.
 void remove_all_vehicles(vehicle_index *vehicles);
 
 /// @}
 
+/// @defgroup slab_functions Slab allocator functions.
+/// @{
+
+/// Initializes an empty slab allocator.
+void init_slab(slab_allocator *allocator, size_t object_size);
+
+/// Allocates an object from a slab allocator.
+void *slab_alloc(slab_allocator *allocator);
+
+/// Returns an object to a slab allocator.
+void slab_free(slab_allocator *allocator, void *object);
+
+/// Releases every slab of an allocator.
+void release_slabs(slab_allocator *allocator);
+
+/// @}
+
 #endif
\ No newline at end of file
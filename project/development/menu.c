@@ -11,32 +11,147 @@
 
 #include "headers.h"
 
+/**
+ * @brief Reads the startup configuration from the command line.
+ *
+ * @param argc Number of command line arguments.
+ * @param argv Command line arguments.
+ * @param conf Configuration to fill.
+ * @return SUCCESSFUL if every option is valid and built in, UNEXPECTED_INPUT
+ * otherwise.
+ */
+error_codes parse_config(int argc, char **argv, config *conf) {
+	int i;
+
+	for (i = 1; i < argc; i++) {
+		if (strcmp(argv[i], MAX_PARKS_OPTION) == 0 && i + 1 < argc) {
+			if (!parse_option(argv[++i], 1, &(conf->max_parks)))
+				return UNEXPECTED_INPUT;
+		} else if (strcmp(argv[i], COMPILE_OPTION) == 0) {
+			conf->mode = COMPILE_MODE;
+		} else if (strcmp(argv[i], REPLAY_OPTION) == 0) {
+			conf->mode = REPLAY_MODE;
+		} else if (strcmp(argv[i], PIPELINE_OPTION) == 0) {
+			conf->mode = PIPELINE_MODE;
+		} else {
+			return UNEXPECTED_INPUT;
+		}
+	}
+
+	return check_threads(conf);
+}
+
+/**
+ * @brief Checks that the threads asked for at startup are built in.
+ *
+ * @param conf Startup configuration.
+ * @return SUCCESSFUL if they are, UNEXPECTED_INPUT after writing a
+ * diagnostic otherwise.
+ */
+error_codes check_threads(config *conf) {
+#ifndef PIPELINED
+	if (conf->mode == PIPELINE_MODE) {
+		fputs(NO_THREADS_MESSAGE PIPELINE_OPTION "\n", stderr);
+		return UNEXPECTED_INPUT;
+	}
+#endif
+	(void)conf;
+	return SUCCESSFUL;
+}
+
+/**
+ * @brief Reads the integer value of a command line option.
+ *
+ * @param str Value of the option.
+ * @param min Smallest value accepted.
+ * @param value Where the value is stored.
+ * @return TRUE if the value is a whole number that fits in an int and is at
+ * least min, FALSE otherwise.
+ */
+bool parse_option(char *str, int min, int *value) {
+	char *end;
+	long int number = strtol(str, &end, 0);
+
+	if (end == str || *end != '\0' || number < min || number > INT_LIMIT)
+		return FALSE;
+
+	*value = number;
+	return TRUE;
+}
+
 /**
  * @brief Main loop function for the menu.
  *
+ * Depending on the startup mode, text commands are executed, compiled into
+ * a command log, a command log is replayed, or text commands run through a
+ * pipeline of threads.
+ *
+ * @param conf Startup configuration.
  * @return SUCCESSFUL if the menu executes successfully,
  * UNEXPECTED if an unexpected error occurs, and UNEXPECTED_INPUT if the
  * menu receives an input that it doesn't know how to handle.
  */
-error_codes menu() {
+error_codes menu(config *conf) {
 	sys system = {
-		.parks = {NULL, NULL, 0},
-		.vehicles = {calloc(HASH_SIZE, sizeof(vehicle *)), HASH_SIZE, 0},
-		.sysdate = {0, 0, 0, 0, 0, 0}};
+		.parks =
+			{NULL, NULL, 0, calloc(HASH_SIZE, sizeof(park *)), HASH_SIZE,
+				conf->max_parks},
+		.sysdate = 0};
+	error_codes result;
 
-	// Main menu loop.
-	while (TRUE) {
-		if (fgets(system.buff, MAX_LINE_BUFF + 1, stdin) == NULL) {
-			free_all(&system.parks, &system.vehicles);
-			return UNEXPECTED_INPUT;
-		}
+	if (!init_vehicle_index(&(system.vehicles))) {
+		free(system.parks.buckets);
+		return UNEXPECTED;
+	}
+	init_output(&(system.out));
+	init_input(&(system.input), &(system.out), conf->mode == REPLAY_MODE);
+	init_slab(&(system.parks.pool), sizeof(park));
+	init_slab(&(system.pools.nodes), sizeof(registry));
+	init_slab(&(system.pools.payloads), sizeof(stay));
+	init_slab(&(system.pools.histories), sizeof(park_history));
+
+	result = run_mode(&system, conf->mode);
+
+	free_all(&system.parks, &system.vehicles, &system.pools);
+	free_input(&(system.input));
+	free_output(&(system.out));
+	return result;
+}
 
-		system.command = remove_whitespaces(system.buff);
-		if (run_command(&system) == SUCCESSFUL_EXIT) break;
+/**
+ * @brief Runs the commands in the startup mode.
+ *
+ * @param system System details structure.
+ * @param mode Startup mode.
+ * @return Result of the mode, as returned by the menu.
+ */
+error_codes run_mode(sys *system, run_modes mode) {
+	if (mode == COMPILE_MODE) {
+		return compile_log(&(system->input), &(system->out));
+	} else if (mode == REPLAY_MODE) {
+		return replay_log(system);
+	} else if (mode == PIPELINE_MODE) {
+		return run_pipeline(system);
 	}
+	return run_commands(system);
+}
 
-	free_all(&system.parks, &system.vehicles);
-	return SUCCESSFUL;
+/**
+ * @brief Reads and executes text commands until the 'q' command.
+ *
+ * @param system System details structure.
+ * @return SUCCESSFUL after the 'q' command, UNEXPECTED_INPUT if the input
+ * ends without one.
+ */
+error_codes run_commands(sys *system) {
+	while (TRUE) {
+		system->command = next_line(&(system->input), &(system->line_size));
+		if (system->command == NULL) return UNEXPECTED_INPUT;
+
+		system->command = remove_whitespaces(system->command);
+		if (run_command(system) == SUCCESSFUL_EXIT) return SUCCESSFUL;
+		reclaim_parks(&system->parks, &system->vehicles, &system->pools);
+	}
 }
 
 /**
@@ -57,17 +172,19 @@ error_codes run_command(sys *system) {
 	case COMMAND_EXIT:
 		return SUCCESSFUL_EXIT;
 	case CREATE_OR_VIEW:
-		return run_p(args, &(system->parks));
+		return run_p(args, &(system->parks), &(system->out));
 	case ADD_VEHICLE:
 		return run_e(args, system);
 	case REMOVE_VEHICLE:
 		return run_s(args, system);
 	case VIEW_VEHICLE:
-		return run_v(args, &(system->vehicles));
+		return run_v(args, &(system->vehicles), &(system->out));
 	case PARK_BILLING:
 		return run_f(args, system);
 	case REMOVE_PARK:
-		return run_r(args, &(system->parks));
+		return run_r(args, system);
+	case SET_TARIFF:
+		return run_t(args, system);
 	default:
 		return UNEXPECTED_INPUT;
 	}
@@ -16,7 +16,22 @@
 /// @{
 
 /// Displays the main menu and handles user input.
-error_codes menu();
+error_codes menu(config *conf);
+
+/// Reads the startup configuration from the command line.
+error_codes parse_config(int argc, char **argv, config *conf);
+
+/// Reads the integer value of a command line option.
+bool parse_option(char *str, int min, int *value);
+
+/// Runs the commands in the startup mode.
+error_codes run_mode(sys *system, run_modes mode);
+
+/// Checks that the threads asked for at startup are built in.
+error_codes check_threads(config *conf);
+
+/// Reads and executes text commands until the 'q' command.
+error_codes run_commands(sys *system);
 
 /// Executes the command specified by the user.
 error_codes run_command(sys *system);
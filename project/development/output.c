@@ -0,0 +1,278 @@
+/**
+ * @file output.c
+ * @author Diogo Santos (ist1110262)
+ * @brief Buffered writer of the standard output.
+ * @version 1
+ * @date 27-03-2024
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "headers.h"
+
+/**
+ * @brief Initializes a writer of the standard output.
+ *
+ * @param out Writer to initialize.
+ */
+void init_output(output_writer *out) {
+	out->sink = NULL;
+	out->fields = FALSE;
+	out->buffer = malloc(OUTPUT_BUFFER_SIZE);
+	out->used = 0;
+	out->cached_day = NO_CACHED_DAY;
+}
+
+/**
+ * @brief Flushes and frees a writer.
+ *
+ * @param out Writer to free.
+ */
+void free_output(output_writer *out) {
+	flush_output(out);
+	free(out->buffer);
+}
+
+/**
+ * @brief Writes the buffered output to the standard output.
+ *
+ * @param out Writer to flush.
+ */
+void flush_output(output_writer *out) {
+	emit_bytes(out, out->buffer, out->used);
+	if (out->sink == NULL) fflush(stdout);
+	out->used = 0;
+}
+
+/**
+ * @brief Hands bytes past the buffer, to the sink of the writer if it has
+ * one and to the standard output otherwise.
+ *
+ * @param out Writer the bytes were written to.
+ * @param str Bytes to hand.
+ * @param size Number of bytes.
+ */
+void emit_bytes(output_writer *out, const char *str, int size) {
+	if (out->sink != NULL) {
+		ring_write(out->sink, str, size);
+	} else {
+		fwrite(str, 1, size, stdout);
+	}
+}
+
+/**
+ * @brief Writes a number of bytes.
+ *
+ * Writes larger than the buffer skip it.
+ *
+ * @param out Writer to write to.
+ * @param str Bytes to write.
+ * @param size Number of bytes.
+ */
+void write_bytes(output_writer *out, const char *str, int size) {
+	if (out->used + size > OUTPUT_BUFFER_SIZE) flush_output(out);
+
+	if (size > OUTPUT_BUFFER_SIZE) {
+		emit_bytes(out, str, size);
+		return;
+	}
+	memcpy(out->buffer + out->used, str, size);
+	out->used += size;
+}
+
+/**
+ * @brief Writes a string.
+ *
+ * @param out Writer to write to.
+ * @param str String to write.
+ */
+void write_str(output_writer *out, const char *str) {
+	write_bytes(out, str, strlen(str));
+}
+
+/**
+ * @brief Writes a character.
+ *
+ * @param out Writer to write to.
+ * @param c Character to write.
+ */
+void write_char(output_writer *out, char c) {
+	if (out->used == OUTPUT_BUFFER_SIZE) flush_output(out);
+	out->buffer[out->used++] = c;
+}
+
+/**
+ * @brief Writes an integer.
+ *
+ * @param out Writer to write to.
+ * @param value Integer to write.
+ */
+void write_int(output_writer *out, long int value) {
+	write_padded(out, value, 1);
+}
+
+/**
+ * @brief Writes an integer, padded with zeros to a width.
+ *
+ * Matches printf with %0*ld, the sign counts towards the width.
+ *
+ * @param out Writer to write to.
+ * @param value Integer to write.
+ * @param width Minimum number of characters.
+ */
+void write_padded(output_writer *out, long int value, int width) {
+	char digits[MAX_NUMBER_SIZE];
+	unsigned long magnitude = value;
+	int size = 0;
+
+	if (out->fields) {
+		write_result(out, INT_FIELD, value, width);
+		return;
+	}
+
+	if (value < 0) {
+		write_char(out, '-');
+		magnitude = -magnitude;
+		width--;
+	}
+
+	do {
+		digits[size++] = '0' + magnitude % 10;
+		magnitude /= 10;
+	} while (magnitude != 0);
+	for (; width > size; width--) write_char(out, '0');
+	while (size > 0) write_char(out, digits[--size]);
+}
+
+/**
+ * @brief Writes a date as DD-MM-YYYY.
+ *
+ * The last day written is kept formatted, as listings repeat the same days,
+ * and only other days are rebuilt from their minutes.
+ *
+ * @param out Writer to write to.
+ * @param total_mins Minutes of the date to write.
+ */
+void write_date(output_writer *out, long int total_mins) {
+	long int day = day_number(total_mins);
+	date fields;
+	int start;
+
+	if (out->fields) {
+		write_result(out, DATE_FIELD, total_mins, 0);
+		return;
+	}
+
+	if (day != out->cached_day) {
+		minutes_to_date(total_mins, &fields);
+		start = out->used;
+		write_padded(out, fields.days, 2);
+		write_char(out, '-');
+		write_padded(out, fields.months, 2);
+		write_char(out, '-');
+		write_padded(out, fields.years, 4);
+
+		// A flush may have split the date, then it isn't cached.
+		if (out->used - start == DATE_READ_SIZE) {
+			memcpy(out->cached_date, out->buffer + start, DATE_READ_SIZE);
+			out->cached_day = day;
+		}
+		return;
+	}
+	write_bytes(out, out->cached_date, DATE_READ_SIZE);
+}
+
+/**
+ * @brief Writes a time as HH:MM.
+ *
+ * @param out Writer to write to.
+ * @param hours Hours to write.
+ * @param minutes Minutes to write.
+ */
+void write_time(output_writer *out, int hours, int minutes) {
+	if (out->fields) {
+		write_result(out, TIME_FIELD, hours * MINS_PER_HOUR + minutes, 0);
+		return;
+	}
+	write_padded(out, hours, 2);
+	write_char(out, ':');
+	write_padded(out, minutes, 2);
+}
+
+/**
+ * @brief Writes a date and its time as DD-MM-YYYY HH:MM.
+ *
+ * @param out Writer to write to.
+ * @param total_mins Minutes of the date to write.
+ */
+void write_stamp(output_writer *out, long int total_mins) {
+	int minutes = minute_of_day(total_mins);
+
+	if (out->fields) {
+		write_result(out, STAMP_FIELD, total_mins, 0);
+		return;
+	}
+	write_date(out, total_mins);
+	write_char(out, ' ');
+	write_time(out, minutes / MINS_PER_HOUR, minutes % MINS_PER_HOUR);
+}
+
+/**
+ * @brief Writes an amount of money with two decimals.
+ *
+ * @param out Writer to write to.
+ * @param cents Amount to write in cents, not negative.
+ */
+void write_money(output_writer *out, money cents) {
+	if (out->fields) {
+		write_result(out, MONEY_FIELD, cents, 0);
+		return;
+	}
+	write_int(out, cents / CENTS_PER_UNIT);
+	write_char(out, '.');
+	write_padded(out, cents % CENTS_PER_UNIT, 2);
+}
+
+/**
+ * @brief Writes a value as a field, to be formatted by the formatter.
+ *
+ * @param out Writer to write to, which writes fields.
+ * @param type Type of the value.
+ * @param value Value to write.
+ * @param width Minimum number of characters of an INT_FIELD.
+ */
+void write_result(
+	output_writer *out, result_fields type, long int value, int width
+) {
+	result_field field = {FIELD_MARKER, type, width, value};
+
+	write_bytes(out, (char *)&field, sizeof(result_field));
+}
+
+/**
+ * @brief Formats a field as text.
+ *
+ * @param out Writer to write the text to, which doesn't write fields.
+ * @param field Field to format.
+ */
+void format_result(output_writer *out, result_field *field) {
+	switch (field->type) {
+	case INT_FIELD:
+		write_padded(out, field->value, field->width);
+		break;
+	case DATE_FIELD:
+		write_date(out, field->value);
+		break;
+	case TIME_FIELD:
+		write_time(out, field->value / MINS_PER_HOUR,
+			field->value % MINS_PER_HOUR);
+		break;
+	case STAMP_FIELD:
+		write_stamp(out, field->value);
+		break;
+	case MONEY_FIELD:
+		write_money(out, field->value);
+		break;
+	}
+}
@@ -0,0 +1,69 @@
+/**
+ * @file output.h
+ * @author Diogo Santos (ist1110262)
+ * @brief Declarations of the buffered output writer.
+ * @version 1
+ * @date 27-03-2024
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef OUTPUT
+#define OUTPUT
+
+#include "headers.h"
+
+/// @defgroup output_functions Output related functions.
+/// @{
+
+/// Initializes a writer of the standard output.
+void init_output(output_writer *out);
+
+/// Flushes and frees a writer.
+void free_output(output_writer *out);
+
+/// Writes the buffered output to its sink or the standard output.
+void flush_output(output_writer *out);
+
+/// Hands bytes past the buffer, to a sink or the standard output.
+void emit_bytes(output_writer *out, const char *str, int size);
+
+/// Writes a number of bytes.
+void write_bytes(output_writer *out, const char *str, int size);
+
+/// Writes a string.
+void write_str(output_writer *out, const char *str);
+
+/// Writes a character.
+void write_char(output_writer *out, char c);
+
+/// Writes an integer.
+void write_int(output_writer *out, long int value);
+
+/// Writes an integer, padded with zeros to a width.
+void write_padded(output_writer *out, long int value, int width);
+
+/// Writes a date as DD-MM-YYYY.
+void write_date(output_writer *out, long int total_mins);
+
+/// Writes a time as HH:MM.
+void write_time(output_writer *out, int hours, int minutes);
+
+/// Writes a date and its time as DD-MM-YYYY HH:MM.
+void write_stamp(output_writer *out, long int total_mins);
+
+/// Writes an amount of money with two decimals.
+void write_money(output_writer *out, money cents);
+
+/// Writes a value as a field, to be formatted by the formatter.
+void write_result(
+	output_writer *out, result_fields type, long int value, int width
+);
+
+/// Formats a field as text.
+void format_result(output_writer *out, result_field *field);
+
+/// @}
+
+#endif
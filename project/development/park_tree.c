@@ -0,0 +1,173 @@
+/**
+ * @file park_tree.c
+ * @author Diogo Santos (ist1110262)
+ * @brief AVL tree of parks ordered by name.
+ * @version 1
+ * @date 27-03-2024
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "headers.h"
+
+/**
+ * @brief Gets the height of a park subtree.
+ *
+ * @param root Root of the subtree.
+ * @return Height of the subtree, 0 if empty.
+ */
+int tree_height(park *root) {
+	return (root == NULL) ? 0 : root->height;
+}
+
+/**
+ * @brief Updates the height of a park from the heights of its children.
+ *
+ * @param root Park to update.
+ */
+void update_height(park *root) {
+	int left = tree_height(root->left), right = tree_height(root->right);
+
+	root->height = ((left > right) ? left : right) + 1;
+}
+
+/**
+ * @brief Rotates a park subtree to the left.
+ *
+ * @param root Root of the subtree.
+ * @return New root of the subtree.
+ */
+park *rotate_left(park *root) {
+	park *pivot = root->right;
+
+	root->right = pivot->left;
+	pivot->left = root;
+	update_height(root);
+	update_height(pivot);
+	return pivot;
+}
+
+/**
+ * @brief Rotates a park subtree to the right.
+ *
+ * @param root Root of the subtree.
+ * @return New root of the subtree.
+ */
+park *rotate_right(park *root) {
+	park *pivot = root->left;
+
+	root->left = pivot->right;
+	pivot->right = root;
+	update_height(root);
+	update_height(pivot);
+	return pivot;
+}
+
+/**
+ * @brief Restores the balance of a park subtree after a change in a child.
+ *
+ * @param root Root of the subtree.
+ * @return New root of the subtree.
+ */
+park *rebalance(park *root) {
+	int balance = tree_height(root->left) - tree_height(root->right);
+
+	if (balance > 1) {
+		if (tree_height(root->left->left) < tree_height(root->left->right))
+			root->left = rotate_left(root->left);
+		return rotate_right(root);
+	} else if (balance < -1) {
+		if (tree_height(root->right->right) < tree_height(root->right->left))
+			root->right = rotate_right(root->right);
+		return rotate_left(root);
+	}
+
+	update_height(root);
+	return root;
+}
+
+/**
+ * @brief Inserts a park in the tree, by name.
+ *
+ * @param root Root of the subtree.
+ * @param new_park Park to insert, its name must not be in the tree.
+ * @return New root of the subtree.
+ */
+park *tree_insert(park *root, park *new_park) {
+	if (root == NULL) {
+		new_park->left = NULL;
+		new_park->right = NULL;
+		new_park->height = 1;
+		return new_park;
+	}
+
+	if (compare_parks(new_park, root) < 0) {
+		root->left = tree_insert(root->left, new_park);
+	} else {
+		root->right = tree_insert(root->right, new_park);
+	}
+	return rebalance(root);
+}
+
+/**
+ * @brief Detaches the first park, by name, from a subtree.
+ *
+ * @param root Root of the subtree, must not be empty.
+ * @param min Where the detached park is stored.
+ * @return New root of the subtree.
+ */
+park *detach_min(park *root, park **min) {
+	if (root->left == NULL) {
+		*min = root;
+		return root->right;
+	}
+
+	root->left = detach_min(root->left, min);
+	return rebalance(root);
+}
+
+/**
+ * @brief Removes a park from the tree.
+ *
+ * @param root Root of the subtree.
+ * @param target Park to remove, must be in the tree.
+ * @return New root of the subtree.
+ */
+park *tree_remove(park *root, park *target) {
+	park *successor;
+
+	if (root == target) {
+		if (root->left == NULL) return root->right;
+		if (root->right == NULL) return root->left;
+
+		// Replace the park by the next one in name order.
+		successor = NULL;
+		root->right = detach_min(root->right, &successor);
+		successor->left = root->left;
+		successor->right = root->right;
+		return rebalance(successor);
+	}
+
+	if (compare_parks(target, root) < 0) {
+		root->left = tree_remove(root->left, target);
+	} else {
+		root->right = tree_remove(root->right, target);
+	}
+	return rebalance(root);
+}
+
+/**
+ * @brief Prints the names of the parks in a subtree, in name order.
+ *
+ * @param root Root of the subtree.
+ * @param out Output writer.
+ */
+void show_park_names(park *root, output_writer *out) {
+	if (root == NULL) return;
+
+	show_park_names(root->left, out);
+	write_str(out, root->name);
+	write_char(out, '\n');
+	show_park_names(root->right, out);
+}
@@ -0,0 +1,49 @@
+/**
+ * @file park_tree.h
+ * @author Diogo Santos (ist1110262)
+ * @brief Declarations of the name ordered tree of parks.
+ * @version 1
+ * @date 27-03-2024
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef PARK_TREE
+#define PARK_TREE
+
+#include "headers.h"
+
+/// @defgroup park_tree_functions Park tree related functions.
+/// @{
+
+/// Get the height of a park subtree.
+int tree_height(park *root);
+
+/// Update the height of a park from its children.
+void update_height(park *root);
+
+/// Rotate a park subtree to the left.
+park *rotate_left(park *root);
+
+/// Rotate a park subtree to the right.
+park *rotate_right(park *root);
+
+/// Restore the balance of a park subtree.
+park *rebalance(park *root);
+
+/// Insert a park in the tree, by name.
+park *tree_insert(park *root, park *new_park);
+
+/// Detach the first park, by name, from a subtree.
+park *detach_min(park *root, park **min);
+
+/// Remove a park from the tree.
+park *tree_remove(park *root, park *target);
+
+/// List the names of the parks in a subtree, in name order.
+void show_park_names(park *root, output_writer *out);
+
+/// @}
+
+#endif
@@ -11,11 +11,6 @@
 
 #include "headers.h"
 
-// Array with total days in a month.
-const int days_in_month[] = {
-	JAN, FEB, MAR, APR, MAY, JUN,
-	JUL, AUG, SEP, OCT, NOV, DEC};
-
 /**
  * @brief Removes leading whitespaces from a string.
  *
@@ -52,21 +47,50 @@ char *delimit(char *str, char delimiter) {
 }
 
 /**
- * @brief Parses a string from a larger string.
+ * @brief Parses a park name, quoted or not, from a string.
+ *
+ * The name is terminated in place, over the delimiter that ends it, and
+ * hashed once so lookups don't hash it again.
  *
- * @param str_start Start of the string to parse.
- * @param str_end End of the string to parse.
- * @param size Size of the string to parse.
- * @return Pointer to the parsed string.
+ * @param str Input string.
+ * @param name Output view of the name.
+ * @return Pointer to the character after the name delimiter, or to the end
+ * of the string if there is no name.
  */
-char *parse_string(char *str_start, char **str_end, int *size) {
-	char *str = malloc(sizeof(char) * (*size + 1));
+char *parse_name(char *str, name_view *name) {
+	char delimiter = ' ', *end;
 
-	strncpy(str, str_start, *size);
-	str[*size] = '\0';
-	*str_end += *size + 1;
+	if (*str == '"') {
+		delimiter = '"';
+		str++;
+	}
+	end = (*str == '\0') ? str : delimit(str, delimiter);
 
-	return str;
+	name->str = str;
+	name->size = end - str;
+	if (*end != '\0') *(end++) = '\0';
+	name->hash = hash(str);
+	return end;
+}
+
+/**
+ * @brief Parses an amount of money, rounded to the nearest cent.
+ *
+ * Amounts are read like strtod does. Those out of range are clamped so
+ * they still convert to cents, and those that are not a number become
+ * negative, an invalid cost.
+ *
+ * @param str Input string.
+ * @param end Where the position after the amount is stored.
+ * @return The amount in cents.
+ */
+money parse_money(char *str, char **end) {
+	double cents = strtod(str, end) * CENTS_PER_UNIT;
+
+	if (!(cents > -MONEY_LIMIT)) cents = -MONEY_LIMIT;
+	if (cents > MONEY_LIMIT) cents = MONEY_LIMIT;
+
+	return (money)(cents + ((cents < 0) ? -0.5 : 0.5));
 }
 
 /**
@@ -74,184 +98,280 @@ char *parse_string(char *str_start, char **str_end, int *size) {
  *
  * @param str Input string.
  * @param license_plate Output string for the license plate.
+ * @param plate_id Output plate id, INVALID_PLATE if the plate is invalid.
  * @return Pointer to the character after the license plate in the input
  * string.
  */
-char *parse_license_plate(char *str, char *license_plate) {
+char *parse_license_plate(
+	char *str, char *license_plate, unsigned int *plate_id
+) {
 	str = remove_whitespaces(str);
 	strncpy(license_plate, str, LICENSE_PLATE_SIZE);
 	license_plate[LICENSE_PLATE_SIZE] = '\0';
+	*plate_id = encode_plate(license_plate);
 
-	return str + LICENSE_PLATE_SIZE;
+	// Short plates are invalid, but reading past the line must be avoided.
+	return str + strlen(license_plate);
 }
 
 /**
- * @brief Parses a date from a string.
+ * @brief Parses a date from a string, as DD-MM-YYYY.
+ *
+ * Fields are read like sscanf reads "%2d-%2d-%4d", so those after the
+ * first one that fails to parse are left unchanged.
  *
  * @param str Input string.
  * @param timestamp Output date structure.
  * @return Pointer to the character after the date in the input string.
  */
 char *parse_date(char *str, date *timestamp) {
+	char *current;
+
 	str = remove_whitespaces(str);
-	sscanf(
-		str, "%2d-%2d-%4d", &(timestamp->days), &(timestamp->months),
-		&(timestamp->years)
+	current = parse_number(str, FIELD_DIGITS, &(timestamp->days));
+	current = parse_field(
+		current, DATE_SEPARATOR, FIELD_DIGITS, &(timestamp->months)
 	);
+	parse_field(current, DATE_SEPARATOR, YEAR_DIGITS, &(timestamp->years));
 
 	return str + DATE_READ_SIZE;
 }
 
 /**
- * @brief Parses a time from a string.
+ * @brief Parses a time from a string, as HH:MM.
+ *
+ * Fields are read like sscanf reads "%2d:%2d".
  *
  * @param str Input string.
  * @param timestamp Output date structure.
  * @return Pointer to the character after the time in the input string.
  */
 char *parse_time(char *str, date *timestamp) {
+	char *current;
+
 	str = remove_whitespaces(str);
-	sscanf(str, "%2d:%2d", &(timestamp->hours), &(timestamp->minutes));
+	current = parse_number(str, FIELD_DIGITS, &(timestamp->hours));
+	parse_field(current, TIME_SEPARATOR, FIELD_DIGITS, &(timestamp->minutes));
 
 	return str + HOUR_READ_SIZE;
 }
 
 /**
- * @brief Calculates the size of a string.
+ * @brief Parses a whole number of limited width, as sscanf reads "%Nd".
+ *
+ * Leading whitespaces are skipped, and a sign counts towards the width.
  *
- * @param args Pointer to the string.
- * @return Size of the string.
+ * @param str Input string.
+ * @param width Maximum number of characters read, sign included.
+ * @param value Output number, left unchanged if there are no digits.
+ * @return Pointer to the character after the number, NULL if there are no
+ * digits.
+ */
+char *parse_number(char *str, int width, int *value) {
+	int number = 0, sign = 1, digits = 0;
+
+	str = remove_whitespaces(str);
+	if (*str == '-' || *str == '+') {
+		if (*str == '-') sign = -1;
+		str++;
+		width--;
+	}
+	for (; digits < width && isdigit(*str); digits++, str++) {
+		number = number * 10 + *str - '0';
+	}
+
+	if (digits == 0) return NULL;
+	*value = sign * number;
+	return str;
+}
+
+/**
+ * @brief Parses a number that follows a separator.
+ *
+ * @param str Input string, NULL if the previous field failed to parse.
+ * @param separator Character that must start the string.
+ * @param width Maximum number of characters of the number, sign included.
+ * @param value Output number, left unchanged if the field fails to parse.
+ * @return Pointer to the character after the number, NULL if the field
+ * fails to parse.
  */
-int str_size(char **args) {
-	char *end_args;
-	if ((*args)[0] != '"')
-		end_args = delimit(*args, ' ');
-	else
-		end_args = delimit(++(*args), '"');
-
-	return end_args - *args;
+char *parse_field(char *str, char separator, int width, int *value) {
+	if (str == NULL || *str != separator) return NULL;
+	return parse_number(str + 1, width, value);
 }
 
 /**
- * @brief Checks if a string is a valid license plate.
+ * @brief Parses the weekdays of a tariff band, as digits from 1 for Monday
+ * to 7 for Sunday.
  *
  * @param str Input string.
- * @return TRUE if the string is a valid license plate, FALSE otherwise.
+ * @param weekdays Output mask with a bit per weekday, 0 if any is invalid.
+ * @return Pointer to the character after the weekdays in the input string.
  */
-bool is_licence_plate(char *str) {
-	bool number_pair = FALSE, letter_pair = FALSE;
-	char *original_str = str;
-
-	while (str < original_str + LICENSE_PLATE_SIZE) {
-		if (isalpha(*str) && isalpha(*(str + 1))) {
-			letter_pair = TRUE;
-		} else if (isdigit(*str) && isdigit(*(str + 1))) {
-			number_pair = TRUE;
-		} else
-			return FALSE;
-
-		if (*(str + 2) != '-') break;
-		str += 3;
+char *parse_weekdays(char *str, int *weekdays) {
+	bool valid = TRUE;
+	int day;
+
+	str = remove_whitespaces(str);
+	for (*weekdays = 0; *str != '\0' && !isspace(*str); str++) {
+		day = *str - FIRST_WEEKDAY;
+		if (day < 0 || day >= DAYS_PER_WEEK) valid = FALSE;
+		else *weekdays |= 1 << day;
 	}
 
-	return number_pair && letter_pair;
+	if (!valid) *weekdays = 0;
+	return str;
 }
 
 /**
- * @brief Converts a date to minutes.
+ * @brief Parses a time of the day, as HH:MM up to 24:00.
  *
- * @param d Pointer to the date structure.
- * @return The date converted to minutes.
+ * @param str Input string.
+ * @param minutes Output minutes since midnight, INVALID_CLOCK if invalid.
+ * @return Pointer to the character after the time in the input string.
  */
-long int date_to_minutes(date *d) {
-	long int minutes;
-	int i;
+char *parse_clock(char *str, int *minutes) {
+	str = remove_whitespaces(str);
+	*minutes = INVALID_CLOCK;
+	if (!isdigit(str[0]) || !isdigit(str[1]) || str[2] != ':' ||
+		!isdigit(str[3]) || !isdigit(str[4])) {
+		return str;
+	}
 
-	minutes = (long int)d->years * DAYS_IN_YEAR * MINS_PER_DAY;
+	*minutes = ((str[0] - '0') * 10 + str[1] - '0') * MINS_PER_HOUR +
+			   (str[3] - '0') * 10 + str[4] - '0';
+	if (str[3] >= '6' || *minutes > MINS_PER_DAY) *minutes = INVALID_CLOCK;
+	return str + HOUR_READ_SIZE;
+}
 
-	for (i = 0; i < (d->months - 1); i++) {
-		minutes += days_in_month[i] * MINS_PER_DAY;
-	}
+/**
+ * @brief Parses a date followed by its time, and converts it to minutes.
+ *
+ * Stamps written exactly as DD-MM-YYYY HH:MM are read in a single pass,
+ * anything else goes through parse_date and parse_time.
+ *
+ * @param str Input string.
+ * @param timestamp Output date structure, total_mins included.
+ * @return Pointer to the character after the time in the input string.
+ */
+char *parse_stamp(char *str, date *timestamp) {
+	char digits[STAMP_SIZE];
 
-	minutes += (d->days - 1) * MINS_PER_DAY;
-	minutes += d->hours * 60;
-	minutes += d->minutes;
+	str = remove_whitespaces(str);
+	if (!is_stamp_shape(str, digits)) {
+		str = parse_date(str, timestamp);
+		str = parse_time(str, timestamp);
+		timestamp->total_mins = date_to_minutes(timestamp);
+		return str;
+	}
 
-	return minutes;
+	timestamp->days = digits[0] * 10 + digits[1];
+	timestamp->months = digits[3] * 10 + digits[4];
+	timestamp->years = (digits[6] * 10 + digits[7]) * 100 + digits[8] * 10 +
+					   digits[9];
+	timestamp->hours = digits[11] * 10 + digits[12];
+	timestamp->minutes = digits[14] * 10 + digits[15];
+	timestamp->total_mins = date_to_minutes(timestamp);
+	return str + STAMP_SIZE;
 }
 
 /**
- * @brief Checks if a date is valid.
+ * @brief Checks if a string starts with a stamp shaped as DD-MM-YYYY HH:MM.
+ *
+ * The stamp is compared a word at a time against STAMP_TEMPLATE: after the
+ * XOR, digits become their value and matching separators become zero, and
+ * adding STAMP_LIMITS sets the top bit of any byte out of place.
  *
- * @param d Pointer to the date structure.
- * @return TRUE if the date is valid, FALSE otherwise.
+ * @param str Input string.
+ * @param digits Output with the value of each digit of the stamp.
+ * @return TRUE if the string starts with a stamp, FALSE otherwise.
  */
-bool is_valid_date(date *d) {
-	if (d->months < 1 || d->months > 12) return FALSE;
-	if (d->days > days_in_month[d->months - 1] || d->days < 1) return FALSE;
-	if (d->hours >= 24 || d->hours < 0) return FALSE;
-	if (d->minutes >= 60 || d->minutes < 0) return FALSE;
+bool is_stamp_shape(char *str, char *digits) {
+	unsigned long text, shape, limits;
+	int i;
+
+	if (memchr(str, '\0', STAMP_SIZE) != NULL) return FALSE;
+
+	for (i = 0; i < STAMP_SIZE; i += sizeof(unsigned long)) {
+		memcpy(&text, str + i, sizeof(unsigned long));
+		memcpy(&shape, STAMP_TEMPLATE + i, sizeof(unsigned long));
+		memcpy(&limits, STAMP_LIMITS + i, sizeof(unsigned long));
 
+		// Top bits are cleared before adding, so no byte carries over.
+		text ^= shape;
+		if ((text | ((text & ~HIGH_BITS) + limits)) & HIGH_BITS) return FALSE;
+		memcpy(digits + i, &text, sizeof(unsigned long));
+	}
 	return TRUE;
 }
 
 /**
- * @brief Calculates the cost of parking.
+ * @brief Encodes a pair of a license plate.
  *
- * @param start Pointer to the start date structure.
- * @param end Pointer to the end date structure.
- * @param parking Pointer to the park structure.
- * @return The cost of parking.
+ * @param pair Pointer to the two characters of the pair.
+ * @return Letter pairs in [0, LETTER_PAIRS[, digit pairs in
+ * [LETTER_PAIRS, PAIR_VALUES[, or PAIR_VALUES if the pair is invalid.
  */
-float calculate_cost(date *start, date *end, park *parking) {
-	int minutes_to_pay = (end->total_mins - start->total_mins), i;
-	float cost, day_cost = 0;
-
-	// Pay for the days
-	cost = (minutes_to_pay / (MINS_PER_DAY)) * parking->day_value;
-	minutes_to_pay = minutes_to_pay % (MINS_PER_DAY);
-
-	// Pay for the first hour
-	for (i = 0; i < TOTAL_INITIAL_BLOCKS; i++) {
-		if (minutes_to_pay == 0) {
-			break;
-		} else if (minutes_to_pay <= PARK_PAY_STEP) {
-			day_cost += parking->first_hour_value;
-			minutes_to_pay = 0;
-			break;
-		}
-		day_cost += parking->first_hour_value;
-		minutes_to_pay -= PARK_PAY_STEP;
-	}
+unsigned int encode_pair(char *pair) {
+	if (pair[0] >= 'A' && pair[0] <= 'Z' && pair[1] >= 'A' && pair[1] <= 'Z')
+		return (pair[0] - 'A') * PLATE_LETTERS + (pair[1] - 'A');
 
-	// Pay for the remaining hours
-	day_cost += (minutes_to_pay / PARK_PAY_STEP) * parking->value;
-	minutes_to_pay = (minutes_to_pay % PARK_PAY_STEP);
+	if (pair[0] >= '0' && pair[0] <= '9' && pair[1] >= '0' && pair[1] <= '9')
+		return LETTER_PAIRS + (pair[0] - '0') * PLATE_DIGITS + (pair[1] - '0');
 
-	if (minutes_to_pay != 0) {
-		day_cost += parking->value;
-	}
+	return PAIR_VALUES;
+}
+
+/**
+ * @brief Validates a license plate and encodes it into its plate id.
+ *
+ * A plate id is the number written by the three pairs in base PAIR_VALUES,
+ * so every valid plate has a distinct id below PLATE_ID_LIMIT.
+ *
+ * @param str License plate with LICENSE_PLATE_SIZE characters.
+ * @return The plate id, or INVALID_PLATE if the plate is invalid.
+ */
+unsigned int encode_plate(char *str) {
+	unsigned int plate_id = 0, pair;
+	int i, letter_pairs = 0;
+
+	for (i = 0; i < PLATE_PAIRS; i++, str += PAIR_STRIDE) {
+		if (i > 0 && str[-1] != PLATE_SEPARATOR) return INVALID_PLATE;
 
-	// Pay only to the daily maximum allowed.
-	if (day_cost > parking->day_value) {
-		cost += parking->day_value;
-	} else {
-		cost += day_cost;
+		pair = encode_pair(str);
+		if (pair == PAIR_VALUES) return INVALID_PLATE;
+		if (pair < LETTER_PAIRS) letter_pairs++;
+		plate_id = plate_id * PAIR_VALUES + pair;
 	}
 
-	return cost;
+	// A plate needs at least one pair of letters and one of digits.
+	if (letter_pairs == 0 || letter_pairs == PLATE_PAIRS) return INVALID_PLATE;
+	return plate_id;
 }
 
 /**
- * @brief Checks if two dates are the same day.
+ * @brief Decodes a plate id back into its license plate.
  *
- * @param d1 Pointer to the first date structure.
- * @param d2 Pointer to the second date structure.
- * @return TRUE if the dates are the same day, FALSE otherwise.
+ * @param plate_id Valid plate id.
+ * @param license_plate Output string, LICENSE_PLATE_SIZE + 1 long.
  */
-bool is_same_day(date *d1, date *d2) {
-	return (
-		(d1->days == d2->days) && (d1->months == d2->months) &&
-		(d1->years == d2->years)
-	);
-}
\ No newline at end of file
+void decode_plate(unsigned int plate_id, char *license_plate) {
+	unsigned int pair;
+	int i;
+
+	license_plate[LICENSE_PLATE_SIZE] = '\0';
+	for (i = PLATE_PAIRS - 1; i >= 0; i--) {
+		pair = plate_id % PAIR_VALUES;
+		plate_id /= PAIR_VALUES;
+
+		if (pair < LETTER_PAIRS) {
+			license_plate[i * PAIR_STRIDE] = 'A' + pair / PLATE_LETTERS;
+			license_plate[i * PAIR_STRIDE + 1] = 'A' + pair % PLATE_LETTERS;
+		} else {
+			pair -= LETTER_PAIRS;
+			license_plate[i * PAIR_STRIDE] = '0' + pair / PLATE_DIGITS;
+			license_plate[i * PAIR_STRIDE + 1] = '0' + pair % PLATE_DIGITS;
+		}
+		if (i > 0) license_plate[i * PAIR_STRIDE - 1] = PLATE_SEPARATOR;
+	}
+}
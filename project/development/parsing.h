@@ -28,11 +28,16 @@ char *delimit(char *str, char delimiter);
 /// @defgroup argument_parsing Argument Parsing.
 /// @{
 
-/// Parse string from the given input.
-char *parse_string(char *str_start, char **str_end, int *size);
+/// Parse a park name from the given input.
+char *parse_name(char *str, name_view *name);
+
+/// Parse an amount of money in cents form a string.
+money parse_money(char *str, char **end);
 
 /// Parse license plate form a string.
-char *parse_license_plate(char *str, char *license_plate);
+char *parse_license_plate(
+	char *str, char *license_plate, unsigned int *plate_id
+);
 
 /// Parse date form a string.
 char *parse_date(char *str, date *timestamp);
@@ -40,33 +45,37 @@ char *parse_date(char *str, date *timestamp);
 /// Parse time form a string.
 char *parse_time(char *str, date *timestamp);
 
-/// Finds the size of a string using its pointers.
-int str_size(char **args);
+/// Parse a whole number of limited width, as sscanf reads "%Nd".
+char *parse_number(char *str, int width, int *value);
 
-/// @}
+/// Parse a number that follows a separator.
+char *parse_field(char *str, char separator, int width, int *value);
 
-/// @defgroup argument_validation Argument validation functions.
-/// @{
+/// Parse the weekdays of a tariff band form a string.
+char *parse_weekdays(char *str, int *weekdays);
 
-/// Validates a licence plate.
-bool is_licence_plate(char *str);
+/// Parse a time of the day, in minutes, form a string.
+char *parse_clock(char *str, int *minutes);
 
-/// Validates a date.
-bool is_valid_date(date *d);
+/// Parse a date followed by its time, converted to minutes.
+char *parse_stamp(char *str, date *timestamp);
 
-/// Verifies if it is the same day.
-bool is_same_day(date *d1, date *d2);
+/// Check if a string starts with a stamp shaped as DD-MM-YYYY HH:MM.
+bool is_stamp_shape(char *str, char *digits);
 
 /// @}
 
-/// @defgroup calculation_functions Calculation related functions.
+/// @defgroup argument_validation Argument validation functions.
 /// @{
 
-/// Transforms date into minutes.
-long int date_to_minutes(date *d);
+/// Encodes a pair of a license plate.
+unsigned int encode_pair(char *pair);
+
+/// Validates a licence plate and encodes it into its plate id.
+unsigned int encode_plate(char *str);
 
-/// Calculates the cost of parking.
-float calculate_cost(date *start, date *end, park *parking);
+/// Decodes a plate id into its license plate.
+void decode_plate(unsigned int plate_id, char *license_plate);
 
 /// @}
 
@@ -0,0 +1,134 @@
+/**
+ * @file pipeline.c
+ * @author Diogo Santos (ist1110262)
+ * @brief Pipeline running the commands across a reader, an executor and a
+ * writer thread.
+ *
+ * The reader parses the text commands into command log records, the
+ * executor replays them against the system, and the formatter turns the
+ * answers into text on the standard output. The executor writes numbers,
+ * dates and money as fields, so the formatter does the formatting. Stages
+ * are connected by byte rings, so each is a single producer or consumer and
+ * the output keeps its order.
+ *
+ * Threads are only used when built with PIPELINED (and -pthread),
+ * otherwise the commands run as in text mode.
+ *
+ * @version 1
+ * @date 27-03-2024
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "headers.h"
+
+/**
+ * @brief Runs the commands through the pipeline, executing them in the
+ * calling thread.
+ *
+ * @param system System details structure.
+ * @return SUCCESSFUL after the 'q' command, UNEXPECTED_INPUT if the input
+ * ends without one.
+ */
+error_codes run_pipeline(sys *system) {
+#ifdef PIPELINED
+	pipeline stages;
+	pthread_t reader, formatter;
+	error_codes result;
+
+	init_stages(&stages);
+	system->input.source = &(stages.commands);
+	system->out.sink = &(stages.results);
+	system->out.fields = TRUE;
+
+	pthread_create(&reader, NULL, run_reader, &stages);
+	pthread_create(&formatter, NULL, run_formatter, &stages);
+	result = replay_log(system);
+
+	// Records after a malformed one are skipped, so the reader can finish.
+	while (next_bytes(&(system->input), 1) != NULL) continue;
+	pthread_join(reader, NULL);
+
+	flush_output(&(system->out));
+	close_ring(&(stages.results));
+	pthread_join(formatter, NULL);
+
+	system->input.source = NULL;
+	system->out.sink = NULL;
+	system->out.fields = FALSE;
+	free_ring(&(stages.commands));
+	free_ring(&(stages.results));
+	return result;
+#else
+	return run_commands(system);
+#endif
+}
+
+#ifdef PIPELINED
+/**
+ * @brief Initializes the rings of a pipeline and its reader and formatter.
+ *
+ * The reader parses the standard input into the commands ring, and the
+ * formatter reads the results ring and writes to the standard output.
+ *
+ * @param stages Stages of the pipeline.
+ */
+void init_stages(pipeline *stages) {
+	init_ring(&(stages->commands));
+	init_ring(&(stages->results));
+
+	init_output(&(stages->out));
+	stages->out.sink = &(stages->commands);
+	init_input(&(stages->input), &(stages->out), FALSE);
+
+	init_output(&(stages->formatter_out));
+	init_input(&(stages->formatter_input), &(stages->formatter_out), TRUE);
+	stages->formatter_input.source = &(stages->results);
+}
+
+/**
+ * @brief Parses the text commands into records for the executor.
+ *
+ * @param arg Stages of the pipeline.
+ * @return NULL.
+ */
+void *run_reader(void *arg) {
+	pipeline *stages = arg;
+
+	compile_log(&(stages->input), &(stages->out));
+	free_output(&(stages->out));
+	free_input(&(stages->input));
+	close_ring(&(stages->commands));
+	return NULL;
+}
+
+/**
+ * @brief Formats the answers of the executor on the standard output.
+ *
+ * @param arg Stages of the pipeline.
+ * @return NULL.
+ */
+void *run_formatter(void *arg) {
+	pipeline *stages = arg;
+	input_reader *in = &(stages->formatter_input);
+	output_writer *out = &(stages->formatter_out);
+	result_field field;
+	char *text;
+	int size;
+
+	while ((text = next_text(in, &size)) != NULL) {
+		if (size > 0) {
+			write_bytes(out, text, size);
+		} else if (read_field(in, &field, sizeof(result_field))) {
+			format_result(out, &field);
+		} else {
+			break;
+		}
+	}
+
+	free_output(out);
+	free_input(in);
+	return NULL;
+}
+#endif
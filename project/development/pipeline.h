@@ -0,0 +1,36 @@
+/**
+ * @file pipeline.h
+ * @author Diogo Santos (ist1110262)
+ * @brief Declarations of the pipeline of threads.
+ * @version 1
+ * @date 27-03-2024
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef PIPELINE
+#define PIPELINE
+
+#include "headers.h"
+
+/// @defgroup pipeline_functions Pipeline related functions.
+/// @{
+
+/// Runs the commands through the pipeline.
+error_codes run_pipeline(sys *system);
+
+#ifdef PIPELINED
+/// Initializes the rings of a pipeline and its reader and formatter.
+void init_stages(pipeline *stages);
+
+/// Parses the text commands into records for the executor.
+void *run_reader(void *arg);
+
+/// Formats the answers of the executor on the standard output.
+void *run_formatter(void *arg);
+#endif
+
+/// @}
+
+#endif
@@ -0,0 +1,177 @@
+/**
+ * @file ring.c
+ * @author Diogo Santos (ist1110262)
+ * @brief Lock-free ring of bytes between a single producer and consumer.
+ *
+ * The producer only moves the tail and the consumer only moves the head,
+ * each published before it is read back by the other side, so the bytes
+ * between them are always seen complete. A lock is only taken by a side
+ * that sleeps on an empty or full ring, and by the other to wake it.
+ *
+ * @version 1
+ * @date 27-03-2024
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "headers.h"
+
+/**
+ * @brief Initializes an empty ring.
+ *
+ * @param ring Ring to initialize.
+ */
+void init_ring(byte_ring *ring) {
+	ring->bytes = malloc(RING_SIZE);
+	ring->head = 0;
+	ring->tail = 0;
+	ring->closed = FALSE;
+	ring->waiting = FALSE;
+#ifdef PIPELINED
+	pthread_mutex_init(&(ring->lock), NULL);
+	pthread_cond_init(&(ring->changed), NULL);
+#endif
+}
+
+/**
+ * @brief Frees the memory of a ring.
+ *
+ * @param ring Ring to free.
+ */
+void free_ring(byte_ring *ring) {
+	free(ring->bytes);
+#ifdef PIPELINED
+	pthread_mutex_destroy(&(ring->lock));
+	pthread_cond_destroy(&(ring->changed));
+#endif
+}
+
+/**
+ * @brief Writes bytes to a ring, waiting while it is full.
+ *
+ * @param ring Ring to write to, from its single producer.
+ * @param bytes Bytes to write.
+ * @param size Number of bytes.
+ */
+void ring_write(byte_ring *ring, const char *bytes, int size) {
+	long int tail = ring->tail, head;
+	int offset, count;
+
+	while (size > 0) {
+		head = __atomic_load_n(&(ring->head), __ATOMIC_ACQUIRE);
+		if (tail - head == RING_SIZE) {
+			wait_ring(ring, &(ring->head), head);
+			continue;
+		}
+
+		offset = tail & RING_MASK;
+		count = RING_SIZE - (tail - head);
+		if (count > RING_SIZE - offset) count = RING_SIZE - offset;
+		if (count > size) count = size;
+
+		memcpy(ring->bytes + offset, bytes, count);
+		tail += count;
+		bytes += count;
+		size -= count;
+		__atomic_store_n(&(ring->tail), tail, __ATOMIC_SEQ_CST);
+		wake_ring(ring);
+	}
+}
+
+/**
+ * @brief Reads the bytes available in a ring, waiting while it is empty.
+ *
+ * @param ring Ring to read from, by its single consumer.
+ * @param bytes Where the bytes are stored.
+ * @param size Most bytes to read.
+ * @return Number of bytes read, 0 once the ring is closed and empty.
+ */
+int ring_read(byte_ring *ring, char *bytes, int size) {
+	long int head = ring->head, tail;
+	int offset, count;
+
+	while ((tail = __atomic_load_n(&(ring->tail), __ATOMIC_ACQUIRE)) == head) {
+		if (__atomic_load_n(&(ring->closed), __ATOMIC_ACQUIRE)) {
+			// Bytes written before closing are seen after it.
+			tail = __atomic_load_n(&(ring->tail), __ATOMIC_ACQUIRE);
+			if (tail == head) return 0;
+			break;
+		}
+		wait_ring(ring, &(ring->tail), head);
+	}
+
+	offset = head & RING_MASK;
+	count = tail - head;
+	if (count > RING_SIZE - offset) count = RING_SIZE - offset;
+	if (count > size) count = size;
+
+	memcpy(bytes, ring->bytes + offset, count);
+	__atomic_store_n(&(ring->head), head + count, __ATOMIC_SEQ_CST);
+	wake_ring(ring);
+	return count;
+}
+
+/**
+ * @brief Closes a ring, after the last bytes of its producer.
+ *
+ * @param ring Ring to close.
+ */
+void close_ring(byte_ring *ring) {
+	__atomic_store_n(&(ring->closed), TRUE, __ATOMIC_SEQ_CST);
+	wake_ring(ring);
+}
+
+/**
+ * @brief Waits for the other side of a ring to move, or for it to close.
+ *
+ * The ring is checked RING_SPINS times before sleeping. A side that moves
+ * only wakes the other when it is marked as waiting, which is marked
+ * before the last check so no wake up is missed.
+ *
+ * @param ring Ring to wait on.
+ * @param position Head or tail of the other side.
+ * @param seen Value of the position that was last seen.
+ */
+void wait_ring(byte_ring *ring, long int *position, long int seen) {
+#ifdef PIPELINED
+	int i;
+
+	for (i = 0; i < RING_SPINS; i++) {
+		if (__atomic_load_n(position, __ATOMIC_ACQUIRE) != seen ||
+			__atomic_load_n(&(ring->closed), __ATOMIC_ACQUIRE)) {
+			return;
+		}
+	}
+
+	pthread_mutex_lock(&(ring->lock));
+	__atomic_store_n(&(ring->waiting), TRUE, __ATOMIC_SEQ_CST);
+	while (__atomic_load_n(position, __ATOMIC_SEQ_CST) == seen &&
+		   !__atomic_load_n(&(ring->closed), __ATOMIC_SEQ_CST)) {
+		pthread_cond_wait(&(ring->changed), &(ring->lock));
+	}
+	__atomic_store_n(&(ring->waiting), FALSE, __ATOMIC_RELAXED);
+	pthread_mutex_unlock(&(ring->lock));
+#else
+	(void)ring;
+	(void)position;
+	(void)seen;
+#endif
+}
+
+/**
+ * @brief Wakes the other side of a ring if it is waiting.
+ *
+ * @param ring Ring that moved or was closed.
+ */
+void wake_ring(byte_ring *ring) {
+#ifdef PIPELINED
+	if (!__atomic_load_n(&(ring->waiting), __ATOMIC_SEQ_CST)) return;
+
+	pthread_mutex_lock(&(ring->lock));
+	pthread_cond_signal(&(ring->changed));
+	pthread_mutex_unlock(&(ring->lock));
+#else
+	(void)ring;
+#endif
+}
@@ -0,0 +1,43 @@
+/**
+ * @file ring.h
+ * @author Diogo Santos (ist1110262)
+ * @brief Declarations of the single producer and consumer byte ring.
+ * @version 1
+ * @date 27-03-2024
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef RING
+#define RING
+
+#include "headers.h"
+
+/// @defgroup ring_functions Ring buffer related functions.
+/// @{
+
+/// Initializes an empty ring.
+void init_ring(byte_ring *ring);
+
+/// Frees the memory of a ring.
+void free_ring(byte_ring *ring);
+
+/// Writes bytes to a ring, waiting while it is full.
+void ring_write(byte_ring *ring, const char *bytes, int size);
+
+/// Reads the bytes available in a ring, waiting while it is empty.
+int ring_read(byte_ring *ring, char *bytes, int size);
+
+/// Closes a ring, after the last bytes of its producer.
+void close_ring(byte_ring *ring);
+
+/// Waits for the other side of a ring to move, or for it to close.
+void wait_ring(byte_ring *ring, long int *position, long int seen);
+
+/// Wakes the other side of a ring if it is waiting.
+void wake_ring(byte_ring *ring);
+
+/// @}
+
+#endif
@@ -18,6 +18,24 @@
 typedef struct park_struct park;
 typedef struct vehicle_struct vehicle;
 
+/// @defgroup allocator_structs Memory allocator related structures.
+/// @{
+
+/// Header of a slab, followed by the objects carved out of it.
+typedef struct slab_struct {
+	struct slab_struct *next;
+} slab;
+
+/// Allocator of fixed size objects carved out of slabs.
+typedef struct {
+	size_t object_size;
+	void *free_list;
+	slab *slabs;
+	char *next_free, *slab_end;
+} slab_allocator;
+
+/// @}
+
 /// Structure to represent a date.
 typedef struct {
 	long int total_mins;
@@ -27,71 +45,103 @@ typedef struct {
 /// @defgroup registry_structs Structures related to registries.
 /// @{
 
-/// Representation of an ENTRY
+/// Representation of a stay, from the entry until the exit of a vehicle.
 typedef struct {
 	vehicle *vehicle_ptr;
 	park *park_ptr;
-	date timestamp;
-} registry_enter;
+	unsigned int park_generation;
+	long int entry, exit;
+	money cost;
+} stay;
 
-/// Representation of an EXIT
+/// Chunk of park events, stored column by column.
 typedef struct {
-	vehicle *vehicle_ptr;
-	park *park_ptr;
-	date timestamp;
-	float cost;
-} registry_exit;
+	long int minutes[EVENT_CHUNK_SIZE];
+	money costs[EVENT_CHUNK_SIZE];
+	unsigned int plates[EVENT_CHUNK_SIZE];
+	unsigned char types[EVENT_CHUNK_SIZE];
+} event_chunk;
 
-/// Union of registries
-typedef union {
-	registry_enter enter;
-	registry_exit exit;
-} registry_union;
+/// Append-only store of the entries and exits of a park.
+typedef struct {
+	event_chunk **chunks;
+	int event_num, chunk_size;
+} event_store;
+
+/// Revenue of a park on a single day and where its exits start.
+typedef struct {
+	long int day;
+	money revenue;
+	int exits, first_exit;
+} ledger_day;
 
 /// Structure to represent a registry.
 typedef struct registration {
-	registry_union *registration;
-	registry_types type;
+	stay *stay_ptr;
 	struct registration *next;
 } registry;
 
+/// Stays of a vehicle in a single park, kept in park name order.
+typedef struct history_struct {
+	registry *registries;
+	registry *last_reg;
+	struct history_struct *next;
+} park_history;
+
 /// @}
 
+/// Prices of the quarter-hours of the week after the first hour of a stay.
+typedef struct {
+	money prices[QUARTERS_PER_WEEK];
+	money sums[SCHEDULE_SUMS];
+} tariff_schedule;
+
 /// @defgroup park_vehicle_structs Parks and Vehicle related structures.
 /// @{
 
 /// Structure to represent a parking lot.
 typedef struct park_struct {
 	char *name;
-	unsigned long hashed_name;
+	unsigned int generation;
+	unsigned long hashed_name, name_key;
 	int capacity, free_spaces;
-	float first_hour_value, value, day_value;
-	registry *registries;
-	registry *last_reg;
+	money value, day_value;
+	money tariff[TARIFF_SLOTS];
+	tariff_schedule *schedule;
+	event_store events;
+	ledger_day *ledger;
+	int ledger_num, ledger_size;
 	struct park_struct *next;
 	struct park_struct *previous;
+	struct park_struct *bucket_next;
+	struct park_struct *left, *right;
+	int height;
 } park;
 
 /// Structure to represent an index of parking lots.
 typedef struct {
 	park *first, *last;
 	int park_num;
+	park **buckets;
+	int size, max_parks;
+	park *root;
+	slab_allocator pool;
+	park *graveyard;
 } park_index;
 
 /// Structure to represent a vehicle.
 typedef struct vehicle_struct {
-	char license_plate[LICENSE_PLATE_SIZE + 1];
-	unsigned long hashed_plate;
-	registry *registries;
-	registry *last_reg;
-	vehicle *next;
+	unsigned int plate_id;
+	park_history *histories;
+	stay *last_stay;
 } vehicle;
 
-/// Structure to represent an index of vehicles.
+/// Open addressing index of vehicles, keyed by plate id.
 typedef struct {
-	vehicle **buckets;
-	int size;
-	int vehicle_num;
+	unsigned int *plates;
+	vehicle **vehicles;
+	slab_allocator pool;
+	int size, shift, vehicle_num;
 } vehicle_index;
 
 /// @}
@@ -99,17 +149,34 @@ typedef struct {
 /// @defgroup command_execution_structs Structures of command arguments.
 /// @{
 
+/// Error of a command, formatted only when it is reported.
+typedef struct {
+	command_errors code;
+	const char *subject;
+	int value;
+} command_error;
+
+/// Name of a park, terminated in place inside the command line.
+typedef struct {
+	char *str;
+	int size;
+	unsigned long hash;
+} name_view;
+
 /// Structure to represent the arguments of 'p' command.
 typedef struct {
-	char *name, err[MAX_LINE_BUFF];
-	int name_size, capacity;
-	float first_value, value, day_value;
+	name_view name;
+	command_error error;
+	int capacity;
+	money first_value, value, day_value;
 } p_args;
 
 /// Structure to represent the arguments of 'e' command.
 typedef struct {
-	int name_size;
-	char *name, license_plate[LICENSE_PLATE_SIZE + 1], err[MAX_LINE_BUFF];
+	name_view name;
+	char license_plate[LICENSE_PLATE_SIZE + 1];
+	command_error error;
+	unsigned int plate_id;
 	date timestamp;
 	park *park;
 	vehicle *vehicle;
@@ -117,44 +184,134 @@ typedef struct {
 
 /// Structure to represent the arguments of 's' command.
 typedef struct {
-	char *name, license_plate[LICENSE_PLATE_SIZE + 1], err[MAX_LINE_BUFF];
-	date start, end;
+	name_view name;
+	char license_plate[LICENSE_PLATE_SIZE + 1];
+	command_error error;
+	unsigned int plate_id;
+	long int start;
+	date end;
 	park *park;
 	vehicle *vehicle;
-	float cost;
+	money cost;
 } s_args;
 
 /// Structure to represent the arguments of 'v' command.
 typedef struct {
-	char err[MAX_LINE_BUFF], license_plate[LICENSE_PLATE_SIZE + 1];
+	char license_plate[LICENSE_PLATE_SIZE + 1];
+	command_error error;
+	unsigned int plate_id;
 	vehicle *vehicle;
-	registry **non_null_regs;
-	int count;
 } v_args;
 
 /// Structure to represent the arguments of 'f' command.
 typedef struct {
-	char *name, err[MAX_LINE_BUFF];
+	name_view name;
+	command_error error;
 	date timestamp;
 	park *park;
-	int name_size;
+	bool has_date;
 } f_args;
 
+/// Structure to represent the arguments of 't' command.
+typedef struct {
+	name_view name;
+	command_error error;
+	int weekdays, start, end;
+	money value;
+	park *park;
+} t_args;
+
 /// Structure to represent the arguments of 'r' command.
 typedef struct {
-	int name_size, count, i;
-	char *name, **names;
+	name_view name;
+	command_error error;
 	park *park;
 } r_args;
 
 /// @}
 
+/// @defgroup pool_structs Registry allocator related structures.
+/// @{
+
+/// Allocators of the registry lists and their payloads.
+typedef struct {
+	slab_allocator nodes, payloads, histories;
+} registry_pools;
+
+/// @}
+
+/// Ring of bytes between a single producer and a single consumer thread.
+typedef struct {
+#ifdef PIPELINED
+	pthread_mutex_t lock;
+	pthread_cond_t changed;
+#endif
+	char *bytes;
+	long int head, tail;
+	bool closed, waiting;
+} byte_ring;
+
+/// Value written for a formatter, after a FIELD_MARKER in place of text.
+typedef struct {
+	char marker, type;
+	int width;
+	long int value;
+} result_field;
+
+/// Buffered writer of the standard output, or of a ring.
+typedef struct {
+	byte_ring *sink;
+	bool fields;
+	char *buffer;
+	int used;
+	long int cached_day;
+	char cached_date[DATE_READ_SIZE];
+} output_writer;
+
+/// Block reader of the standard input, or of a ring, splitting the input
+/// into lines in place.
+typedef struct {
+	byte_ring *source;
+	output_writer *out;
+	char *block, *sentinel, saved;
+	int start, end;
+	bool whole_blocks, eof;
+} input_reader;
+
+/// Park names of a command log, identified by their order of definition,
+/// and the parks they name while the log is replayed.
+typedef struct {
+	name_view *names;
+	park **parks;
+	int name_num, name_size;
+	int *slots;
+	int slot_size;
+} name_table;
+
+/// Rings between the stages of the pipeline, and the input and output of
+/// the reader and formatter stages.
+typedef struct {
+	byte_ring commands, results;
+	input_reader input, formatter_input;
+	output_writer out, formatter_out;
+} pipeline;
+
+/// Structure to represent the startup configuration.
+typedef struct {
+	int max_parks;
+	run_modes mode;
+} config;
+
 /// Structure to represent the system vars.
 typedef struct {
-	char buff[MAX_LINE_BUFF + 1], *command;
+	input_reader input;
+	output_writer out;
+	char *command;
+	int line_size;
 	park_index parks;
 	vehicle_index vehicles;
-	date sysdate;
+	registry_pools pools;
+	long int sysdate;
 } sys;
 
 #endif
\ No newline at end of file
@@ -0,0 +1,143 @@
+/**
+ * @file tariff.c
+ * @author Diogo Santos (ist1110262)
+ * @brief Compiled tariffs of the parks and the cost of a stay.
+ *
+ * A park compiles its tariff into the cost of each number of started
+ * quarter-hours in a day. Parks with tariff bands also get a schedule: the
+ * price of each quarter-hour of the week after the first hour, and the
+ * prefix sums of those prices, so any stay costs a single subtraction.
+ *
+ * @version 1
+ * @date 27-03-2024
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "headers.h"
+
+/**
+ * @brief Compiles the tariff of a park into the cost of each number of
+ * started quarter-hours in a day, capped at the daily maximum.
+ *
+ * @param parking Park whose tariff is compiled.
+ * @param first_value Cost of each quarter-hour of the first hour.
+ * @param value Cost of each quarter-hour after the first hour.
+ */
+void compile_tariff(park *parking, money first_value, money value) {
+	money cost = 0;
+	int slot;
+
+	parking->value = value;
+	parking->schedule = NULL;
+	parking->tariff[0] = 0;
+	for (slot = 1; slot < TARIFF_SLOTS; slot++) {
+		cost += (slot <= TOTAL_INITIAL_BLOCKS) ? first_value : value;
+		parking->tariff[slot] =
+			(cost > parking->day_value) ? parking->day_value : cost;
+	}
+}
+
+/**
+ * @brief Sets the price of the quarter-hours of a band in the schedule of a
+ * park, creating the schedule on the first band.
+ *
+ * Quarter-hours of the clock are priced by the band they start in, and
+ * later bands override earlier ones.
+ *
+ * @param parking Park the band belongs to.
+ * @param args Arguments of the 't' command.
+ */
+void add_band(park *parking, t_args *args) {
+	tariff_schedule *schedule = parking->schedule;
+	int day, quarter, first, last;
+
+	if (schedule == NULL) {
+		schedule = malloc(sizeof(tariff_schedule));
+		for (quarter = 0; quarter < QUARTERS_PER_WEEK; quarter++) {
+			schedule->prices[quarter] = parking->value;
+		}
+		parking->schedule = schedule;
+	}
+
+	first = (args->start + PARK_PAY_STEP - 1) / PARK_PAY_STEP;
+	last = (args->end + PARK_PAY_STEP - 1) / PARK_PAY_STEP;
+	for (day = 0; day < DAYS_PER_WEEK; day++) {
+		if (!(args->weekdays & (1 << day))) continue;
+		for (quarter = first; quarter < last; quarter++) {
+			schedule->prices[day * QUARTERS_PER_DAY + quarter] = args->value;
+		}
+	}
+	compile_schedule(schedule);
+}
+
+/**
+ * @brief Sums the prices of a schedule over two weeks, so that any day
+ * long window of quarter-hours is a difference of two sums.
+ *
+ * @param schedule Schedule to compile.
+ */
+void compile_schedule(tariff_schedule *schedule) {
+	int i;
+
+	schedule->sums[0] = 0;
+	for (i = 0; i < SCHEDULE_SUMS - 1; i++) {
+		schedule->sums[i + 1] =
+			schedule->sums[i] + schedule->prices[i % QUARTERS_PER_WEEK];
+	}
+}
+
+/**
+ * @brief Calculates the cost of parking.
+ *
+ * Full days cost the daily maximum, and the rest of the stay is looked up
+ * by its started quarter-hours in the compiled tariff, or in the schedule
+ * if the park has one.
+ *
+ * @param start Minutes of the entry.
+ * @param end Minutes of the exit.
+ * @param parking Pointer to the park structure.
+ * @return The cost of parking.
+ */
+money calculate_cost(long int start, long int end, park *parking) {
+	long int days = (end - start) / MINS_PER_DAY;
+	int slots = ((end - start) % MINS_PER_DAY + PARK_PAY_STEP - 1)
+		/ PARK_PAY_STEP;
+
+	if (parking->schedule != NULL) {
+		return days * parking->day_value +
+			   scheduled_cost(parking, start + days * MINS_PER_DAY, slots);
+	}
+	return days * parking->day_value + parking->tariff[slots];
+}
+
+/**
+ * @brief Calculates the cost of less than a day in a park with a schedule.
+ *
+ * The first hour costs as in the tariff, and each later quarter-hour costs
+ * the price of the quarter-hour of the week it starts in.
+ *
+ * @param parking Park with a schedule.
+ * @param start Minutes the rest of the stay starts at.
+ * @param slots Started quarter-hours of the rest of the stay.
+ * @return The cost, capped at the daily maximum.
+ */
+money scheduled_cost(park *parking, long int start, int slots) {
+	money *sums = parking->schedule->sums, cost;
+	int first = (slots < TOTAL_INITIAL_BLOCKS) ? slots : TOTAL_INITIAL_BLOCKS;
+	int split = (MINS_PER_DAY - minute_of_day(start) + PARK_PAY_STEP - 1) /
+		PARK_PAY_STEP;
+	int quarter = quarter_of_week(start) + first, next_quarter;
+
+	// Quarter-hours after midnight start again from the weekday of the next
+	// day, which skips one more day after a 28-02 of a leap year.
+	if (split < first) split = first;
+	if (split > slots) split = slots;
+	next_quarter = quarter_of_week(start + split * PARK_PAY_STEP);
+
+	cost = parking->tariff[first] + sums[quarter + split - first] -
+		   sums[quarter] + sums[next_quarter + slots - split] -
+		   sums[next_quarter];
+	return (cost > parking->day_value) ? parking->day_value : cost;
+}
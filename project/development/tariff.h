@@ -0,0 +1,37 @@
+/**
+ * @file tariff.h
+ * @author Diogo Santos (ist1110262)
+ * @brief Declarations of the compiled tariffs.
+ * @version 1
+ * @date 27-03-2024
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef TARIFF
+#define TARIFF
+
+#include "headers.h"
+
+/// @defgroup calculation_functions Calculation related functions.
+/// @{
+
+/// Compiles the tariff of a park into the cost of each quarter-hour count.
+void compile_tariff(park *parking, money first_value, money value);
+
+/// Sets the price of the quarter-hours of a band in a park schedule.
+void add_band(park *parking, t_args *args);
+
+/// Compiles the prefix sums of the prices of a schedule.
+void compile_schedule(tariff_schedule *schedule);
+
+/// Calculates the cost of parking.
+money calculate_cost(long int start, long int end, park *parking);
+
+/// Calculates the cost of less than a day in a park with a schedule.
+money scheduled_cost(park *parking, long int start, int slots);
+
+/// @}
+
+#endif
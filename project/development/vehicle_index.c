@@ -0,0 +1,202 @@
+/**
+ * @file vehicle_index.c
+ * @author Diogo Santos (ist1110262)
+ * @brief Open addressing index of vehicles keyed by plate id.
+ * @version 1
+ * @date 27-03-2024
+ *
+ * @copyright Copyright (c) 2024
+ *
+ * Plate ids are kept in their own array, so a probe compares consecutive
+ * integers and only reads the vehicle of the slot that matches. Collisions
+ * are resolved by linear probing, and removals shift the following entries
+ * back instead of leaving tombstones.
+ */
+
+#include "headers.h"
+
+/**
+ * @brief Initializes an empty vehicle index.
+ *
+ * @param vehicles Vehicle index.
+ * @return TRUE if the slots were allocated, FALSE otherwise.
+ */
+bool init_vehicle_index(vehicle_index *vehicles) {
+	init_slab(&(vehicles->pool), sizeof(vehicle));
+	vehicles->vehicle_num = 0;
+	return alloc_slots(vehicles, VEHICLE_INDEX_SIZE);
+}
+
+/**
+ * @brief Allocates empty slots for the vehicle index.
+ *
+ * @param vehicles Vehicle index, its old slots are left to the caller.
+ * @param size Number of slots, a power of two.
+ * @return TRUE if the slots were allocated, FALSE otherwise.
+ */
+bool alloc_slots(vehicle_index *vehicles, int size) {
+	int i;
+
+	vehicles->plates = malloc(size * sizeof(unsigned int));
+	vehicles->vehicles = malloc(size * sizeof(vehicle *));
+	if (vehicles->plates == NULL || vehicles->vehicles == NULL) {
+		free(vehicles->plates);
+		free(vehicles->vehicles);
+		return FALSE;
+	}
+
+	vehicles->size = size;
+	vehicles->shift = PLATE_HASH_BITS;
+	for (i = 1; i < size; i *= 2) vehicles->shift--;
+	for (i = 0; i < size; i++) vehicles->plates[i] = EMPTY_SLOT;
+	return TRUE;
+}
+
+/**
+ * @brief Gets the slot where the probe for a plate id starts.
+ *
+ * @param plate_id Plate id of the vehicle.
+ * @param vehicles Vehicle index.
+ * @return The top bits of the hashed plate id.
+ */
+int home_slot(unsigned int plate_id, vehicle_index *vehicles) {
+	return (plate_id * PLATE_MULTIPLIER) >> vehicles->shift;
+}
+
+/**
+ * @brief Finds the slot of a plate id.
+ *
+ * @param plate_id Plate id of the vehicle.
+ * @param vehicles Vehicle index.
+ * @return The slot holding the plate id, or the empty slot where it would
+ * be added.
+ */
+int find_slot(unsigned int plate_id, vehicle_index *vehicles) {
+	int mask = vehicles->size - 1, slot = home_slot(plate_id, vehicles);
+
+	while (vehicles->plates[slot] != plate_id &&
+		vehicles->plates[slot] != EMPTY_SLOT) {
+		slot = (slot + 1) & mask;
+	}
+	return slot;
+}
+
+/**
+ * @brief Moves every vehicle of the index to a new number of slots.
+ *
+ * @param vehicles Vehicle index.
+ * @param new_size New number of slots, a power of two.
+ * @return TRUE if resized, FALSE if the index was left as it was.
+ */
+bool resize_vehicle_index(vehicle_index *vehicles, int new_size) {
+	unsigned int *old_plates = vehicles->plates;
+	vehicle **old_vehicles = vehicles->vehicles;
+	int old_size = vehicles->size, old_shift = vehicles->shift, i, slot;
+
+	if (!alloc_slots(vehicles, new_size)) {
+		vehicles->plates = old_plates;
+		vehicles->vehicles = old_vehicles;
+		vehicles->size = old_size;
+		vehicles->shift = old_shift;
+		return FALSE;
+	}
+
+	for (i = 0; i < old_size; i++) {
+		if (old_plates[i] == EMPTY_SLOT) continue;
+		slot = find_slot(old_plates[i], vehicles);
+		vehicles->plates[slot] = old_plates[i];
+		vehicles->vehicles[slot] = old_vehicles[i];
+	}
+
+	free(old_plates);
+	free(old_vehicles);
+	return TRUE;
+}
+
+/**
+ * @brief Adds a new vehicle to the vehicle index.
+ *
+ * @param plate_id Plate id of the vehicle, must be valid.
+ * @param vehicles Vehicle index.
+ * @return Pointer to the new vehicle, NULL if the index can't grow.
+ */
+vehicle *add_vehicle(unsigned int plate_id, vehicle_index *vehicles) {
+	float load = (float)(vehicles->vehicle_num + 1) / vehicles->size;
+	vehicle *new_vehicle;
+	int slot;
+
+	if (load > MAX_LOAD_FACTOR &&
+		!resize_vehicle_index(vehicles, vehicles->size * GROWTH_FACTOR)) {
+		return NULL;
+	}
+
+	new_vehicle = slab_alloc(&(vehicles->pool));
+	new_vehicle->plate_id = plate_id;
+	new_vehicle->histories = NULL;
+	new_vehicle->last_stay = NULL;
+
+	slot = find_slot(plate_id, vehicles);
+	vehicles->plates[slot] = plate_id;
+	vehicles->vehicles[slot] = new_vehicle;
+	vehicles->vehicle_num++;
+	return new_vehicle;
+}
+
+/**
+ * @brief Removes a vehicle from the vehicle index.
+ *
+ * The index is shrunk once it is mostly empty.
+ *
+ * @param owner Vehicle to remove, its histories must already be freed.
+ * @param vehicles Vehicle index.
+ */
+void remove_vehicle(vehicle *owner, vehicle_index *vehicles) {
+	clear_slot(find_slot(owner->plate_id, vehicles), vehicles);
+	slab_free(&(vehicles->pool), owner);
+	vehicles->vehicle_num--;
+
+	if (vehicles->size > VEHICLE_INDEX_SIZE &&
+		vehicles->vehicle_num < vehicles->size * MIN_LOAD_FACTOR) {
+		resize_vehicle_index(vehicles, vehicles->size / GROWTH_FACTOR);
+	}
+}
+
+/**
+ * @brief Empties a slot, moving back the entries probed past it.
+ *
+ * @param slot Slot to empty.
+ * @param vehicles Vehicle index.
+ */
+void clear_slot(int slot, vehicle_index *vehicles) {
+	int mask = vehicles->size - 1, next = (slot + 1) & mask, home;
+
+	while (vehicles->plates[next] != EMPTY_SLOT) {
+		home = home_slot(vehicles->plates[next], vehicles);
+
+		// An entry can fill the hole when its probe starts at or before it.
+		if (((next - home) & mask) >= ((next - slot) & mask)) {
+			vehicles->plates[slot] = vehicles->plates[next];
+			vehicles->vehicles[slot] = vehicles->vehicles[next];
+			slot = next;
+		}
+		next = (next + 1) & mask;
+	}
+	vehicles->plates[slot] = EMPTY_SLOT;
+}
+
+/**
+ * @brief Finds a vehicle in the vehicle index.
+ *
+ * @param plate_id Plate id of the vehicle.
+ * @param vehicles Vehicle index.
+ * @return Pointer to the vehicle if found, NULL otherwise.
+ */
+vehicle *find_vehicle(unsigned int plate_id, vehicle_index *vehicles) {
+	int slot;
+
+	if (plate_id >= PLATE_ID_LIMIT) return NULL;
+	slot = find_slot(plate_id, vehicles);
+	if (vehicles->plates[slot] == EMPTY_SLOT) return NULL;
+
+	return vehicles->vehicles[slot];
+}
@@ -0,0 +1,49 @@
+/**
+ * @file vehicle_index.h
+ * @author Diogo Santos (ist1110262)
+ * @brief Declarations of the vehicle index keyed by plate id.
+ * @version 1
+ * @date 27-03-2024
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef VEHICLE_INDEX
+#define VEHICLE_INDEX
+
+#include "headers.h"
+
+/// @defgroup vehicle_index_functions Vehicle index related functions.
+/// @{
+
+/// Initializes an empty vehicle index.
+bool init_vehicle_index(vehicle_index *vehicles);
+
+/// Allocates empty slots for the vehicle index.
+bool alloc_slots(vehicle_index *vehicles, int size);
+
+/// Gets the slot where the probe for a plate id starts.
+int home_slot(unsigned int plate_id, vehicle_index *vehicles);
+
+/// Finds the slot of a plate id, or the empty slot where it would go.
+int find_slot(unsigned int plate_id, vehicle_index *vehicles);
+
+/// Moves every vehicle of the index to a new number of slots.
+bool resize_vehicle_index(vehicle_index *vehicles, int new_size);
+
+/// Add a new vehicle to the vehicle index.
+vehicle *add_vehicle(unsigned int plate_id, vehicle_index *vehicles);
+
+/// Remove a vehicle from the vehicle index.
+void remove_vehicle(vehicle *owner, vehicle_index *vehicles);
+
+/// Empties a slot, moving back the entries probed past it.
+void clear_slot(int slot, vehicle_index *vehicles);
+
+/// Find a vehicle by its plate id.
+vehicle *find_vehicle(unsigned int plate_id, vehicle_index *vehicles);
+
+/// @}
+
+#endif